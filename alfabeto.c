@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "alfabeto.h"
+
+// Tabelas geradas a partir de LISTA_ALFABETO em tempo de compilacao
+#define LETRA_PARA_INDICE(minuscula, maiuscula, indice) [minuscula] = (indice) + 1,
+#define INDICE_PARA_MINUSCULA(minuscula, maiuscula, indice) [indice] = (minuscula),
+#define INDICE_PARA_MAIUSCULA(minuscula, maiuscula, indice) [indice] = (maiuscula),
+#define MAIUSCULA_PARA_MINUSCULA(minuscula, maiuscula, indice) [maiuscula] = (minuscula),
+
+const unsigned char INDICE_ALFABETO[256] = {LISTA_ALFABETO(LETRA_PARA_INDICE)};
+const unsigned char MINUSCULA_ALFABETO[TAMANHO_ALFABETO] = {LISTA_ALFABETO(INDICE_PARA_MINUSCULA)};
+const unsigned char MAIUSCULA_ALFABETO[TAMANHO_ALFABETO] = {LISTA_ALFABETO(INDICE_PARA_MAIUSCULA)};
+
+// Minuscula de cada letra do alfabeto (0 = byte fica como esta)
+static const unsigned char DOBRA_ALFABETO[256] = {LISTA_ALFABETO(MAIUSCULA_PARA_MINUSCULA)};
+
+// Caractere que nao cabe num byte; nunca faz parte do alfabeto
+#define LETRA_DESCONHECIDA '?'
+
+// Passa uma letra (byte Latin-1) pra minuscula do alfabeto
+char dobrar_letra(char c)
+{
+    unsigned char b = (unsigned char)c;
+    return (char)(DOBRA_ALFABETO[b] ? DOBRA_ALFABETO[b] : b);
+}
+
+// Converte o codigo de um caractere pro byte usado internamente
+static char codigo_para_letra(unsigned long codigo)
+{
+    return codigo > 0xFF ? LETRA_DESCONHECIDA : dobrar_letra((char)codigo);
+}
+
+// Quantos bytes de continuacao um byte inicial de UTF-8 pede (0 = nao e inicio)
+static int bytes_extras_utf8(int primeiro)
+{
+    if ((primeiro & 0xE0) == 0xC0)
+    {
+        return 1;
+    }
+    if ((primeiro & 0xF0) == 0xE0)
+    {
+        return 2;
+    }
+    if ((primeiro & 0xF8) == 0xF0)
+    {
+        return 3;
+    }
+    return 0;
+}
+
+// Le a proxima letra do arquivo pulando espacos e quebras de linha, ja
+// convertida de UTF-8 pra minuscula. Bytes que nao formam UTF-8 valido sao
+// tratados como Latin-1. Retorna EOF no fim do arquivo
+int ler_letra(FILE *f)
+{
+    int c;
+    do
+    {
+        c = getc(f);
+    } while (c != EOF && c < 0x80 && isspace(c));
+
+    if (c == EOF)
+    {
+        return EOF;
+    }
+
+    int extras = bytes_extras_utf8(c);
+    if (extras == 0)
+    {
+        return (unsigned char)dobrar_letra((char)c);
+    }
+
+    unsigned long codigo = c & (0x3F >> extras);
+    for (int k = 0; k < extras; k++)
+    {
+        int proximo = getc(f);
+        if (proximo == EOF || (proximo & 0xC0) != 0x80)
+        {
+            if (proximo != EOF)
+            {
+                ungetc(proximo, f);
+            }
+            return (unsigned char)(k == 0 ? dobrar_letra((char)c) : LETRA_DESCONHECIDA);
+        }
+        codigo = (codigo << 6) | (proximo & 0x3F);
+    }
+
+    return (unsigned char)codigo_para_letra(codigo);
+}
+
+// Converte uma palavra lida em UTF-8 pra letras minusculas de um byte, no
+// proprio buffer (o resultado nunca fica maior que a entrada)
+void normalizar_palavra(char *palavra)
+{
+    const unsigned char *origem = (const unsigned char *)palavra;
+    char *destino = palavra;
+
+    while (*origem)
+    {
+        int extras = bytes_extras_utf8(*origem);
+        unsigned long codigo = *origem & (0x3F >> extras);
+        int k = 0;
+
+        while (k < extras && (origem[k + 1] & 0xC0) == 0x80)
+        {
+            codigo = (codigo << 6) | (origem[k + 1] & 0x3F);
+            k++;
+        }
+
+        if (extras == 0 || k == 0)
+        {
+            *destino++ = dobrar_letra((char)*origem);
+            origem++;
+        }
+        else
+        {
+            *destino++ = k == extras ? codigo_para_letra(codigo) : LETRA_DESCONHECIDA;
+            origem += k + 1;
+        }
+    }
+
+    *destino = '\0';
+}
+
+// Escreve a letra em UTF-8 no destino e retorna quantos bytes usou (1 ou 2)
+int letra_para_utf8(char letra, char *destino)
+{
+    unsigned char b = (unsigned char)letra;
+    if (b < 0x80)
+    {
+        destino[0] = (char)b;
+        return 1;
+    }
+    destino[0] = (char)(0xC0 | (b >> 6));
+    destino[1] = (char)(0x80 | (b & 0x3F));
+    return 2;
+}
+
+// Imprime a palavra em UTF-8 completando com espacos ate largura letras
+void imprimir_letras(const char *palavra, int largura)
+{
+    int letras = 0;
+    for (; palavra[letras]; letras++)
+    {
+        char utf8[2];
+        fwrite(utf8, 1, letra_para_utf8(palavra[letras], utf8), stdout);
+    }
+    for (; letras < largura; letras++)
+    {
+        putchar(' ');
+    }
+}
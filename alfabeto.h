@@ -0,0 +1,55 @@
+#ifndef ALFABETO_H
+#define ALFABETO_H
+
+#include <stdio.h>
+
+// Letras aceitas no tabuleiro e no dicionario. Cada linha e
+// X(minuscula, maiuscula, indice na trie), com as letras em Latin-1.
+// Os arquivos sao lidos em UTF-8 e convertidos uma vez so na carga pra
+// esses bytes; dai pra frente tudo anda por INDICE_LETRA. Pra mudar o
+// alfabeto basta mexer nesta lista (os indices precisam ser 0, 1, 2, ...)
+#define LISTA_ALFABETO(X)                                       \
+    X('a', 'A', 0) X('b', 'B', 1) X('c', 'C', 2) X('d', 'D', 3) \
+    X('e', 'E', 4) X('f', 'F', 5) X('g', 'G', 6) X('h', 'H', 7) \
+    X('i', 'I', 8) X('j', 'J', 9) X('k', 'K', 10)               \
+    X('l', 'L', 11) X('m', 'M', 12) X('n', 'N', 13)             \
+    X('o', 'O', 14) X('p', 'P', 15) X('q', 'Q', 16)             \
+    X('r', 'R', 17) X('s', 'S', 18) X('t', 'T', 19)             \
+    X('u', 'U', 20) X('v', 'V', 21) X('w', 'W', 22)             \
+    X('x', 'X', 23) X('y', 'Y', 24) X('z', 'Z', 25)             \
+    X(0xE1, 0xC1, 26) /* a agudo */                             \
+    X(0xE0, 0xC0, 27) /* a crase */                             \
+    X(0xE2, 0xC2, 28) /* a circunflexo */                       \
+    X(0xE3, 0xC3, 29) /* a til */                               \
+    X(0xE9, 0xC9, 30) /* e agudo */                             \
+    X(0xEA, 0xCA, 31) /* e circunflexo */                       \
+    X(0xED, 0xCD, 32) /* i agudo */                             \
+    X(0xF3, 0xD3, 33) /* o agudo */                             \
+    X(0xF4, 0xD4, 34) /* o circunflexo */                       \
+    X(0xF5, 0xD5, 35) /* o til */                               \
+    X(0xFA, 0xDA, 36) /* u agudo */                             \
+    X(0xE7, 0xC7, 37) /* c cedilha */                           \
+    X('0', '0', 38) X('1', '1', 39) X('2', '2', 40)             \
+    X('3', '3', 41) X('4', '4', 42) X('5', '5', 43)             \
+    X('6', '6', 44) X('7', '7', 45) X('8', '8', 46)             \
+    X('9', '9', 47)
+
+#define CONTAR_LETRA(minuscula, maiuscula, indice) +1
+#define TAMANHO_ALFABETO (0 LISTA_ALFABETO(CONTAR_LETRA))
+
+// INDICE_ALFABETO[byte] e o indice da letra minuscula mais 1 (0 = fora do
+// alfabeto). Maiusculas ja foram convertidas na carga e nao aparecem aqui
+extern const unsigned char INDICE_ALFABETO[256];
+extern const unsigned char MINUSCULA_ALFABETO[TAMANHO_ALFABETO];
+extern const unsigned char MAIUSCULA_ALFABETO[TAMANHO_ALFABETO];
+
+// Indice da letra na trie, ou -1 se ela nao faz parte do alfabeto
+#define INDICE_LETRA(c) ((int)INDICE_ALFABETO[(unsigned char)(c)] - 1)
+
+char dobrar_letra(char c);
+int ler_letra(FILE *f);
+void normalizar_palavra(char *palavra);
+int letra_para_utf8(char letra, char *destino);
+void imprimir_letras(const char *palavra, int largura);
+
+#endif
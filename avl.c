@@ -2,27 +2,28 @@
 #include <stdlib.h>
 #include <string.h>
 #include "avl.h"
+#include "saida.h"
 
 // Funçao auxiliar pra retornar o maior entre dois numeros inteiros
-int max(int a, int b)
+static int max(int a, int b)
 {
     return (a > b) ? a : b;
 }
 
 // Retorna a altura de um no ou 0 se ele for nulo (vazio)
-int altura(NoAVL *no)
+static int altura(NoAVL *no)
 {
     return no ? no->altura : 0;
 }
 
 // Calcula o balanco do no: altura da esquerda menos altura da direita
-int fator_balanceamento(NoAVL *no)
+static int fator_balanceamento(NoAVL *no)
 {
     return no ? altura(no->esquerdo) - altura(no->direito) : 0;
 }
 
 // Recalcula a altura do no com base na altura dos filhos mais 1
-void atualizar_altura(NoAVL *no)
+static void atualizar_altura(NoAVL *no)
 {
     if (no)
     {
@@ -31,7 +32,7 @@ void atualizar_altura(NoAVL *no)
 }
 
 // Faz a rotacao simples para a direita pra balancear a arvore
-NoAVL *rotacao_direita(NoAVL *y)
+static NoAVL *rotacao_direita(NoAVL *y)
 {
     NoAVL *x = y->esquerdo;
     NoAVL *T2 = x->direito;
@@ -46,7 +47,7 @@ NoAVL *rotacao_direita(NoAVL *y)
 }
 
 // Faz a rotacao simples para a esquerda pra corrigir desequilibrio
-NoAVL *rotacao_esquerda(NoAVL *x)
+static NoAVL *rotacao_esquerda(NoAVL *x)
 {
     NoAVL *y = x->direito;
     NoAVL *T2 = y->esquerdo;
@@ -73,6 +74,37 @@ NoAVL *criar_no_avl(const char *palavra, Coordenadas coord)
     return no;
 }
 
+// Depois de inserir a palavra abaixo de raiz, aplica as rotacoes se precisar balancear
+static NoAVL *balancear_insercao(NoAVL *raiz, const char *palavra)
+{
+    atualizar_altura(raiz);
+    int fb = fator_balanceamento(raiz);
+
+    if (fb > 1 && strcmp(palavra, raiz->esquerdo->palavra) < 0)
+    {
+        return rotacao_direita(raiz);
+    }
+
+    if (fb < -1 && strcmp(palavra, raiz->direito->palavra) > 0)
+    {
+        return rotacao_esquerda(raiz);
+    }
+
+    if (fb > 1 && strcmp(palavra, raiz->esquerdo->palavra) > 0)
+    {
+        raiz->esquerdo = rotacao_esquerda(raiz->esquerdo);
+        return rotacao_direita(raiz);
+    }
+
+    if (fb < -1 && strcmp(palavra, raiz->direito->palavra) < 0)
+    {
+        raiz->direito = rotacao_direita(raiz->direito);
+        return rotacao_esquerda(raiz);
+    }
+
+    return raiz;
+}
+
 // Insere uma palavra na arvore e aplica rotacoes se precisar balancear
 NoAVL *inserir_avl(NoAVL *raiz, const char *palavra, Coordenadas coord)
 {
@@ -96,36 +128,41 @@ NoAVL *inserir_avl(NoAVL *raiz, const char *palavra, Coordenadas coord)
         return raiz;
     }
 
-    atualizar_altura(raiz);
-    int fb = fator_balanceamento(raiz);
+    return balancear_insercao(raiz, palavra);
+}
 
-    if (fb > 1 && strcmp(palavra, raiz->esquerdo->palavra) < 0)
+// Igual a inserir_avl, mas usa um no ja preparado por quem chamou (palavra e
+// coord preenchidas). Se a palavra ja existir o no novo e ignorado
+NoAVL *inserir_no_avl(NoAVL *raiz, NoAVL *novo)
+{
+    if (!raiz)
     {
-        return rotacao_direita(raiz);
+        novo->esquerdo = NULL;
+        novo->direito = NULL;
+        novo->altura = 1;
+        return novo;
     }
 
-    if (fb < -1 && strcmp(palavra, raiz->direito->palavra) > 0)
+    int cmp = strcmp(novo->palavra, raiz->palavra);
+
+    if (cmp < 0)
     {
-        return rotacao_esquerda(raiz);
+        raiz->esquerdo = inserir_no_avl(raiz->esquerdo, novo);
     }
-
-    if (fb > 1 && strcmp(palavra, raiz->esquerdo->palavra) > 0)
+    else if (cmp > 0)
     {
-        raiz->esquerdo = rotacao_esquerda(raiz->esquerdo);
-        return rotacao_direita(raiz);
+        raiz->direito = inserir_no_avl(raiz->direito, novo);
     }
-
-    if (fb < -1 && strcmp(palavra, raiz->direito->palavra) < 0)
+    else
     {
-        raiz->direito = rotacao_direita(raiz->direito);
-        return rotacao_esquerda(raiz);
+        return raiz;
     }
 
-    return raiz;
+    return balancear_insercao(raiz, novo->palavra);
 }
 
 // Busca o no com menor valor (mais a esquerda) pra ajudar na remocao
-NoAVL *obter_menor(NoAVL *no)
+static NoAVL *obter_menor(NoAVL *no)
 {
     NoAVL *atual = no;
     while (atual && atual->esquerdo)
@@ -161,15 +198,14 @@ NoAVL *remover_avl(NoAVL *raiz, const char *palavra)
 
             if (!temp)
             {
-                temp = raiz;
-                raiz = NULL;
-            }
-            else
-            {
-                *raiz = *temp;
+                free(raiz->palavra);
+                free(raiz);
+                return NULL;
             }
 
-            free(temp->palavra);
+            // O filho toma o lugar do no; a palavra dele passa a ser do no
+            free(raiz->palavra);
+            *raiz = *temp;
             free(temp);
         }
         else
@@ -216,19 +252,6 @@ NoAVL *remover_avl(NoAVL *raiz, const char *palavra)
     return raiz;
 }
 
-// Funcao recursiva que imprime a arvore em ordem alfabetica (esq-raiz-dir)
-void imprimir_avl_recursivo(NoAVL *raiz)
-{
-    if (raiz)
-    {
-        imprimir_avl_recursivo(raiz->esquerdo);
-        printf("%-15s [(%d,%d) -> (%d,%d)]\n", raiz->palavra,
-               raiz->coord.linha_inicio, raiz->coord.coluna_inicio,
-               raiz->coord.linha_fim, raiz->coord.coluna_fim);
-        imprimir_avl_recursivo(raiz->direito);
-    }
-}
-
 // Funcao principal pra exibir todas as palavras achadas no jogo
 void imprimir_avl(NoAVL *raiz)
 {
@@ -239,7 +262,12 @@ void imprimir_avl(NoAVL *raiz)
     }
     else
     {
-        imprimir_avl_recursivo(raiz);
+        // As linhas saem pelo escritor com buffer, entao o que o printf
+        // guardou precisa sair antes
+        fflush(stdout);
+        EscritorSaida *e = criar_escritor(SAIDA_PADRAO, SAIDA_TEXTO, CAPACIDADE_SAIDA_PADRAO);
+        escrever_resultados(e, raiz);
+        liberar_escritor(e);
     }
     printf("\n");
 }
@@ -268,6 +296,22 @@ int buscar_avl(NoAVL *raiz, const char *palavra)
     }
 }
 
+// Igual a buscar_avl, mas devolve o proprio no pra quem precisa mexer nas coordenadas
+NoAVL *buscar_no_avl(NoAVL *raiz, const char *palavra)
+{
+    while (raiz)
+    {
+        int cmp = strcmp(palavra, raiz->palavra);
+
+        if (cmp == 0)
+        {
+            return raiz;
+        }
+        raiz = cmp < 0 ? raiz->esquerdo : raiz->direito;
+    }
+    return NULL;
+}
+
 // Libera toda memoria alocada pela arvore pra nao vazar memoria
 void liberar_avl(NoAVL *raiz)
 {
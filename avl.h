@@ -21,9 +21,11 @@ typedef struct NoAVL
 // Apenas protótipos das funções
 NoAVL *criar_no_avl(const char *palavra, Coordenadas coord);
 NoAVL *inserir_avl(NoAVL *raiz, const char *palavra, Coordenadas coord);
+NoAVL *inserir_no_avl(NoAVL *raiz, NoAVL *novo);
 NoAVL *remover_avl(NoAVL *raiz, const char *palavra);
 void imprimir_avl(NoAVL *raiz);
 void liberar_avl(NoAVL *raiz);
 int buscar_avl(NoAVL *raiz, const char *palavra);
+NoAVL *buscar_no_avl(NoAVL *raiz, const char *palavra);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,446 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "avl.h"
+#include "trie.h"
+#include "jogo.h"
+#include "cache.h"
+
+#ifdef _WIN32
+#include <process.h>
+#include <sys/utime.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+// Identificacao e versao do formato do arquivo de cache
+#define MAGICO_CACHE "CPAL"
+#define FORMATO_CACHE 2
+#define EXTENSAO_CACHE ".cpr"
+
+// Temporarios mais velhos que isso sao de um processo que morreu no meio
+#define IDADE_TEMPORARIO_SEGUNDOS 3600
+
+// FNV-1a 64 bits
+#define FNV_INICIO 14695981039346656037ULL
+#define FNV_PRIMO 1099511628211ULL
+
+static unsigned long long fnv_byte(unsigned long long h, unsigned char b)
+{
+    return (h ^ b) * FNV_PRIMO;
+}
+
+// Hash do tamanho e de todas as letras do tabuleiro
+unsigned long long hash_tabuleiro(Tabuleiro *tab)
+{
+    unsigned long long h = FNV_INICIO;
+    for (int k = 0; k < 4; k++)
+    {
+        h = fnv_byte(h, (unsigned char)((unsigned)tab->tamanho >> (8 * k)));
+    }
+    for (int i = 0; i < tab->tamanho; i++)
+    {
+        for (int j = 0; j < tab->tamanho; j++)
+        {
+            h = fnv_byte(h, (unsigned char)tab->matriz[i][j]);
+        }
+    }
+    return h;
+}
+
+// Passa pela trie em ordem e mistura cada letra e cada fim de palavra
+static unsigned long long hash_trie(NoTrie *no, unsigned long long h)
+{
+    h = fnv_byte(h, no->fim_palavra ? '$' : '.');
+    for (int i = 0; i < TAMANHO_ALFABETO; i++)
+    {
+        if (no->filhos[i])
+        {
+            h = fnv_byte(h, MINUSCULA_ALFABETO[i]);
+            h = hash_trie(no->filhos[i], h);
+            h = fnv_byte(h, '^');
+        }
+    }
+    return h;
+}
+
+// Versao do dicionario: depende so do conjunto de palavras, nao da ordem no arquivo
+unsigned long long versao_dicionario(NoTrie *trie)
+{
+    return trie ? hash_trie(trie, FNV_INICIO) : FNV_INICIO;
+}
+
+// Inteiros sempre em little-endian pra o arquivo valer em qualquer maquina
+static void escrever_inteiro(FILE *f, unsigned long long v, int bytes)
+{
+    for (int k = 0; k < bytes; k++)
+    {
+        putc((int)((v >> (8 * k)) & 0xFF), f);
+    }
+}
+
+static int ler_inteiro(FILE *f, unsigned long long *v, int bytes)
+{
+    *v = 0;
+    for (int k = 0; k < bytes; k++)
+    {
+        int c = getc(f);
+        if (c == EOF)
+        {
+            return 0;
+        }
+        *v |= (unsigned long long)c << (8 * k);
+    }
+    return 1;
+}
+
+// Caminho do arquivo de um par (tabuleiro, dicionario)
+static void caminho_cache(char *caminho, size_t tamanho, const char *diretorio,
+                          unsigned long long chave, unsigned long long versao)
+{
+    snprintf(caminho, tamanho, "%s/%016llx-%016llx" EXTENSAO_CACHE, diretorio, chave, versao);
+}
+
+static int contar_avl(NoAVL *raiz)
+{
+    return raiz ? 1 + contar_avl(raiz->esquerdo) + contar_avl(raiz->direito) : 0;
+}
+
+// Grava as palavras em ordem alfabetica
+static void escrever_avl(FILE *f, NoAVL *raiz)
+{
+    if (raiz)
+    {
+        escrever_avl(f, raiz->esquerdo);
+        size_t tamanho = strlen(raiz->palavra);
+        escrever_inteiro(f, tamanho, 2);
+        fwrite(raiz->palavra, 1, tamanho, f);
+        escrever_inteiro(f, (unsigned)raiz->coord.linha_inicio, 4);
+        escrever_inteiro(f, (unsigned)raiz->coord.coluna_inicio, 4);
+        escrever_inteiro(f, (unsigned)raiz->coord.linha_fim, 4);
+        escrever_inteiro(f, (unsigned)raiz->coord.coluna_fim, 4);
+        escrever_avl(f, raiz->direito);
+    }
+}
+
+// O hash so escolhe o arquivo; as letras gravadas nele e que confirmam que o
+// resultado e mesmo deste tabuleiro (colisoes de FNV sao faceis de montar)
+static int conferir_tabuleiro(FILE *f, Tabuleiro *tab)
+{
+    char *linha = (char *)malloc(tab->tamanho > 0 ? tab->tamanho : 1);
+    int ok = 1;
+
+    for (int i = 0; i < tab->tamanho && ok; i++)
+    {
+        ok = fread(linha, 1, tab->tamanho, f) == (size_t)tab->tamanho &&
+             memcmp(linha, tab->matriz[i], tab->tamanho) == 0;
+    }
+
+    free(linha);
+    return ok;
+}
+
+// Buffers usados enquanto a arvore e remontada do arquivo
+typedef struct
+{
+    FILE *f;
+    char *palavra;
+    char *anterior;
+    int ok;
+} LeituraCache;
+
+static int ler_coordenada(FILE *f, int *valor)
+{
+    unsigned long long v;
+    if (!ler_inteiro(f, &v, 4))
+    {
+        return 0;
+    }
+    *valor = v >= 0x80000000ULL ? (int)((long long)v - 0x100000000LL) : (int)v;
+    return 1;
+}
+
+// Monta uma AVL ja balanceada com os proximos n registros (que estao em ordem):
+// metade vai pra esquerda, um pra raiz e o resto pra direita
+static NoAVL *ler_arvore(LeituraCache *l, int n)
+{
+    if (n <= 0 || !l->ok)
+    {
+        return NULL;
+    }
+
+    NoAVL *esquerdo = ler_arvore(l, (n - 1) / 2);
+    if (!l->ok)
+    {
+        return esquerdo;
+    }
+
+    unsigned long long tamanho;
+    Coordenadas coord;
+    if (!ler_inteiro(l->f, &tamanho, 2) ||
+        fread(l->palavra, 1, (size_t)tamanho, l->f) != (size_t)tamanho ||
+        !ler_coordenada(l->f, &coord.linha_inicio) ||
+        !ler_coordenada(l->f, &coord.coluna_inicio) ||
+        !ler_coordenada(l->f, &coord.linha_fim) ||
+        !ler_coordenada(l->f, &coord.coluna_fim))
+    {
+        l->ok = 0;
+        return esquerdo;
+    }
+    l->palavra[tamanho] = '\0';
+
+    // Fora de ordem quer dizer arquivo estragado
+    if (l->anterior[0] != '\0' && strcmp(l->anterior, l->palavra) >= 0)
+    {
+        l->ok = 0;
+        return esquerdo;
+    }
+    char *troca = l->anterior;
+    l->anterior = l->palavra;
+    l->palavra = troca;
+
+    NoAVL *no = criar_no_avl(l->anterior, coord);
+    no->esquerdo = esquerdo;
+    no->direito = ler_arvore(l, n - 1 - (n - 1) / 2);
+
+    int ae = no->esquerdo ? no->esquerdo->altura : 0;
+    int ad = no->direito ? no->direito->altura : 0;
+    no->altura = 1 + (ae > ad ? ae : ad);
+    return no;
+}
+
+int carregar_cache(const char *diretorio, Tabuleiro *tab, unsigned long long versao, NoAVL **resultado)
+{
+    *resultado = NULL;
+
+    unsigned long long chave = hash_tabuleiro(tab);
+    char caminho[4096];
+    caminho_cache(caminho, sizeof(caminho), diretorio, chave, versao);
+
+    FILE *f = fopen(caminho, "rb");
+    if (!f)
+    {
+        return 0;
+    }
+
+    char magico[4];
+    unsigned long long formato, chave_lida, versao_lida, tamanho, total;
+    int ok = fread(magico, 1, 4, f) == 4 && memcmp(magico, MAGICO_CACHE, 4) == 0 &&
+             ler_inteiro(f, &formato, 4) && formato == FORMATO_CACHE &&
+             ler_inteiro(f, &chave_lida, 8) && chave_lida == chave &&
+             ler_inteiro(f, &versao_lida, 8) && versao_lida == versao &&
+             ler_inteiro(f, &tamanho, 4) && tamanho == (unsigned)tab->tamanho &&
+             ler_inteiro(f, &total, 4) && total <= 0x7FFFFFFF &&
+             conferir_tabuleiro(f, tab);
+
+    NoAVL *avl = NULL;
+    if (ok)
+    {
+        LeituraCache l;
+        l.f = f;
+        l.palavra = (char *)malloc(0x10000);
+        l.anterior = (char *)malloc(0x10000);
+        l.anterior[0] = '\0';
+        l.ok = 1;
+
+        avl = ler_arvore(&l, (int)total);
+        ok = l.ok && getc(f) == EOF;
+
+        free(l.palavra);
+        free(l.anterior);
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        liberar_avl(avl);
+        return 0;
+    }
+
+    // Marca o arquivo como usado agora pra ele ser o ultimo a sair
+    utime(caminho, NULL);
+
+    *resultado = avl;
+    return 1;
+}
+
+// Cria um arquivo temporario com nome unico no diretorio (O_EXCL evita que
+// dois processos ou threads escrevam no mesmo temporario)
+static FILE *abrir_temporario(char *caminho, size_t tamanho, const char *final)
+{
+    for (int tentativa = 0; tentativa < 1000; tentativa++)
+    {
+        snprintf(caminho, tamanho, "%s.%ld.%d.tmp", final, (long)getpid(), tentativa);
+        int fd = open(caminho, O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd >= 0)
+        {
+            return fdopen(fd, "wb");
+        }
+        if (errno != EEXIST)
+        {
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+// Arquivo do cache visto na hora de limpar o diretorio
+typedef struct
+{
+    char *caminho;
+    long long bytes;
+    time_t modificado;
+} EntradaCache;
+
+static int comparar_entradas(const void *a, const void *b)
+{
+    const EntradaCache *x = (const EntradaCache *)a;
+    const EntradaCache *y = (const EntradaCache *)b;
+    return (x->modificado > y->modificado) - (x->modificado < y->modificado);
+}
+
+static int termina_com(const char *nome, const char *fim)
+{
+    size_t n = strlen(nome), m = strlen(fim);
+    return n >= m && strcmp(nome + n - m, fim) == 0;
+}
+
+// Apaga os arquivos menos usados ate o diretorio caber no limite, sem tocar
+// no que acabou de ser gravado. Se outro processo apagar o mesmo arquivo
+// antes, o remove so falha e seguimos
+static void limitar_cache(const char *diretorio, const char *manter, long long limite_bytes)
+{
+    DIR *d = opendir(diretorio);
+    if (!d)
+    {
+        return;
+    }
+
+    EntradaCache *entradas = NULL;
+    int total = 0, capacidade = 0;
+    long long soma = 0;
+    time_t agora = time(NULL);
+    struct dirent *e;
+
+    while ((e = readdir(d)) != NULL)
+    {
+        int temporario = termina_com(e->d_name, ".tmp");
+        if (!temporario && !termina_com(e->d_name, EXTENSAO_CACHE))
+        {
+            continue;
+        }
+
+        char caminho[4096];
+        struct stat st;
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, e->d_name);
+        if (stat(caminho, &st) != 0)
+        {
+            continue;
+        }
+
+        if (temporario)
+        {
+            if (agora - st.st_mtime > IDADE_TEMPORARIO_SEGUNDOS)
+            {
+                remove(caminho);
+            }
+            continue;
+        }
+
+        if (total == capacidade)
+        {
+            capacidade = capacidade ? capacidade * 2 : 64;
+            entradas = (EntradaCache *)realloc(entradas, capacidade * sizeof(EntradaCache));
+        }
+        entradas[total].caminho = (char *)malloc(strlen(caminho) + 1);
+        strcpy(entradas[total].caminho, caminho);
+        entradas[total].bytes = (long long)st.st_size;
+        entradas[total].modificado = st.st_mtime;
+        soma += entradas[total].bytes;
+        total++;
+    }
+    closedir(d);
+
+    if (soma > limite_bytes)
+    {
+        qsort(entradas, total, sizeof(EntradaCache), comparar_entradas);
+        for (int i = 0; i < total && soma > limite_bytes; i++)
+        {
+            if (strcmp(entradas[i].caminho, manter) != 0)
+            {
+                remove(entradas[i].caminho);
+                soma -= entradas[i].bytes;
+            }
+        }
+    }
+
+    for (int i = 0; i < total; i++)
+    {
+        free(entradas[i].caminho);
+    }
+    free(entradas);
+}
+
+// Escreve num temporario e depois renomeia: quem le nunca ve arquivo pela metade
+// e, se dois processos gravarem a mesma chave, o conteudo e o mesmo
+int salvar_cache(const char *diretorio, Tabuleiro *tab, unsigned long long versao,
+                 NoAVL *avl, long long limite_bytes)
+{
+    unsigned long long chave = hash_tabuleiro(tab);
+    char caminho[4096];
+    char temporario[4200];
+    caminho_cache(caminho, sizeof(caminho), diretorio, chave, versao);
+
+    FILE *f = abrir_temporario(temporario, sizeof(temporario), caminho);
+    if (!f)
+    {
+        return 0;
+    }
+
+    fwrite(MAGICO_CACHE, 1, 4, f);
+    escrever_inteiro(f, FORMATO_CACHE, 4);
+    escrever_inteiro(f, chave, 8);
+    escrever_inteiro(f, versao, 8);
+    escrever_inteiro(f, (unsigned)tab->tamanho, 4);
+    escrever_inteiro(f, (unsigned)contar_avl(avl), 4);
+    for (int i = 0; i < tab->tamanho; i++)
+    {
+        fwrite(tab->matriz[i], 1, tab->tamanho, f);
+    }
+    escrever_avl(f, avl);
+
+    int ok = fflush(f) == 0;
+#ifndef _WIN32
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = fclose(f) == 0 && ok;
+
+#ifdef _WIN32
+    // No Windows rename nao substitui um arquivo que ja existe
+    if (ok)
+    {
+        remove(caminho);
+    }
+#endif
+    if (!ok || rename(temporario, caminho) != 0)
+    {
+        remove(temporario);
+        return 0;
+    }
+
+    if (limite_bytes > 0)
+    {
+        limitar_cache(diretorio, caminho, limite_bytes);
+    }
+    return 1;
+}
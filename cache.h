@@ -0,0 +1,25 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "trie.h"
+#include "avl.h"
+#include "jogo.h"
+
+// Limite padrao do diretorio de cache, em bytes
+#define LIMITE_CACHE_PADRAO (64LL * 1024 * 1024)
+
+// Hash das letras do tabuleiro e do conjunto de palavras do dicionario
+unsigned long long hash_tabuleiro(Tabuleiro *tab);
+unsigned long long versao_dicionario(NoTrie *trie);
+
+// Procura o resultado de (tabuleiro, dicionario) no diretorio. Retorna 1 e
+// preenche resultado se achou, ou 0 se nao tem (ou o arquivo esta estragado)
+int carregar_cache(const char *diretorio, Tabuleiro *tab, unsigned long long versao, NoAVL **resultado);
+
+// Grava o resultado, junto com as letras do tabuleiro (conferidas na leitura,
+// o hash so escolhe o arquivo), no diretorio e apaga os arquivos mais antigos ate o total
+// ficar abaixo de limite_bytes. Varios processos podem gravar no mesmo diretorio
+int salvar_cache(const char *diretorio, Tabuleiro *tab, unsigned long long versao,
+                 NoAVL *avl, long long limite_bytes);
+
+#endif
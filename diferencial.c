@@ -0,0 +1,904 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "avl.h"
+#include "trie.h"
+#include "jogo.h"
+#include "particao.h"
+#include "resolvedor.h"
+#include "cache.h"
+#include "maiores.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define mkdir(caminho, modo) _mkdir(caminho)
+#define rmdir _rmdir
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Compara buscar_palavras com cada caminho otimizado em tabuleiros e
+// dicionarios sorteados. A primeira diferenca e reduzida ate um caso minimo,
+// que e impresso no formato de tabuleiro.txt e palavras.txt
+
+#define CASOS_PADRAO 500
+#define TAMANHO_MAXIMO_PADRAO 40
+
+// buscar_palavras monta as palavras num buffer de 100 letras
+#define MAIOR_TABULEIRO 99
+
+#define MAX_PALAVRAS 48
+#define MAIOR_PALAVRA 12
+#define MAX_LETRAS_CASO 4
+#define MAX_TENTATIVAS_REDUCAO 20000
+#define TAMANHO_DETALHE 512
+
+// Limites dos parametros sorteados pros motores
+#define MAX_PROCESSOS 4
+#define MAIOR_BLOCO 24
+#define MAIOR_K 12
+
+// Prazo das buscas com tempo limitado e quantas vezes cada caso estoura ele
+#define PRAZO_TESTE_MS 1
+#define MAX_ATRASOS 1
+
+// Um tabuleiro com o seu dicionario
+typedef struct
+{
+    int tamanho;
+    char *celulas; // tamanho * tamanho letras, linha por linha
+    int num_palavras;
+    char palavras[MAX_PALAVRAS][MAIOR_PALAVRA + 1];
+    int processos;    // busca em blocos
+    int bloco;
+    int k;            // buscar_maiores_palavras
+    unsigned semente; // pontos de cancelamento da busca incremental
+} Caso;
+
+// Roda um caminho otimizado e compara com a referencia. Retorna 1 se bateu;
+// se nao, descreve a primeira diferenca em detalhe
+typedef int (*FuncaoMotor)(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe);
+
+typedef struct
+{
+    const char *nome;
+    FuncaoMotor funcao;
+} Motor;
+
+// Arquivos que os motores precisam em disco
+static char diretorio_temporario[256];
+static char arquivo_tabuleiro[300];
+static char diretorio_cache[300];
+
+// xorshift de 32 bits; o estado nunca pode ser 0
+static unsigned sortear(unsigned *estado)
+{
+    unsigned x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado = x;
+    return x;
+}
+
+static int sortear_ate(unsigned *estado, int limite)
+{
+    return (int)(sortear(estado) % (unsigned)limite);
+}
+
+// ---------------------------------------------------------------------------
+// Casos
+
+static void copiar_caso(Caso *destino, Caso *origem)
+{
+    *destino = *origem;
+    destino->celulas = (char *)malloc(origem->tamanho * origem->tamanho);
+    memcpy(destino->celulas, origem->celulas, origem->tamanho * origem->tamanho);
+}
+
+// Palavra de letras sorteadas entre as do caso
+static void palavra_aleatoria(char *palavra, const char *letras, int num_letras, unsigned *sorteio)
+{
+    int tamanho = 1 + sortear_ate(sorteio, 8);
+    for (int i = 0; i < tamanho; i++)
+    {
+        palavra[i] = letras[sortear_ate(sorteio, num_letras)];
+    }
+    palavra[tamanho] = '\0';
+}
+
+// Copia um trecho do tabuleiro numa das 8 direcoes, pra garantir que a
+// palavra aparece (as vezes so de tras pra frente)
+static void palavra_plantada(char *palavra, Caso *c, unsigned *sorteio)
+{
+    static const int DIRECOES[8][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1},
+                                       {0, -1}, {-1, 0}, {-1, -1}, {-1, 1}};
+    int linha = sortear_ate(sorteio, c->tamanho);
+    int coluna = sortear_ate(sorteio, c->tamanho);
+    int d = sortear_ate(sorteio, 8);
+    int tamanho = 2 + sortear_ate(sorteio, MAIOR_PALAVRA - 1);
+    int n = 0;
+
+    while (n < tamanho && linha >= 0 && linha < c->tamanho && coluna >= 0 && coluna < c->tamanho)
+    {
+        palavra[n++] = c->celulas[linha * c->tamanho + coluna];
+        linha += DIRECOES[d][0];
+        coluna += DIRECOES[d][1];
+    }
+    palavra[n] = '\0';
+}
+
+// Palindromo de tamanho par ou impar
+static void palavra_palindromo(char *palavra, const char *letras, int num_letras, unsigned *sorteio)
+{
+    int metade = 1 + sortear_ate(sorteio, 4);
+    int tamanho = 2 * metade - sortear_ate(sorteio, 2);
+    for (int i = 0; i < metade; i++)
+    {
+        palavra[i] = palavra[tamanho - 1 - i] = letras[sortear_ate(sorteio, num_letras)];
+    }
+    palavra[tamanho] = '\0';
+}
+
+// Sorteia um tabuleiro com poucas letras (pra ter muitas ocorrencias e
+// repeticoes) e um dicionario com palavras soltas, trechos do tabuleiro,
+// palindromos, prefixos e palavras invertidas
+static void gerar_caso(Caso *c, unsigned *sorteio, int tamanho_maximo)
+{
+    char letras[MAX_LETRAS_CASO];
+    int num_letras = 1 + sortear_ate(sorteio, MAX_LETRAS_CASO);
+    for (int i = 0; i < num_letras; i++)
+    {
+        // Quase sempre letras comuns, as vezes acentos e digitos
+        int indice = sortear_ate(sorteio, 4) ? sortear_ate(sorteio, 26) : sortear_ate(sorteio, TAMANHO_ALFABETO);
+        letras[i] = (char)MINUSCULA_ALFABETO[indice];
+    }
+
+    c->tamanho = 1 + sortear_ate(sorteio, tamanho_maximo);
+    c->celulas = (char *)malloc(c->tamanho * c->tamanho);
+    for (int i = 0; i < c->tamanho * c->tamanho; i++)
+    {
+        c->celulas[i] = letras[sortear_ate(sorteio, num_letras)];
+    }
+
+    c->num_palavras = 1 + sortear_ate(sorteio, MAX_PALAVRAS);
+    for (int i = 0; i < c->num_palavras; i++)
+    {
+        char *palavra = c->palavras[i];
+        switch (sortear_ate(sorteio, 5))
+        {
+        case 0:
+            palavra_aleatoria(palavra, letras, num_letras, sorteio);
+            break;
+        case 1:
+        case 2:
+            palavra_plantada(palavra, c, sorteio);
+            break;
+        case 3:
+            palavra_palindromo(palavra, letras, num_letras, sorteio);
+            break;
+        default:
+            // Prefixo ou inverso de uma palavra anterior
+            if (i == 0)
+            {
+                palavra_aleatoria(palavra, letras, num_letras, sorteio);
+                break;
+            }
+            strcpy(palavra, c->palavras[sortear_ate(sorteio, i)]);
+            int tamanho = (int)strlen(palavra);
+            if (sortear_ate(sorteio, 2))
+            {
+                palavra[1 + sortear_ate(sorteio, tamanho)] = '\0';
+            }
+            else
+            {
+                for (int a = 0, b = tamanho - 1; a < b; a++, b--)
+                {
+                    char temp = palavra[a];
+                    palavra[a] = palavra[b];
+                    palavra[b] = temp;
+                }
+            }
+            break;
+        }
+
+        // Um trecho que saiu do tabuleiro logo na primeira letra fica vazio
+        if (palavra[0] == '\0')
+        {
+            palavra_aleatoria(palavra, letras, num_letras, sorteio);
+        }
+    }
+
+    c->processos = 1 + sortear_ate(sorteio, MAX_PROCESSOS);
+    c->bloco = 1 + sortear_ate(sorteio, MAIOR_BLOCO);
+    c->k = 1 + sortear_ate(sorteio, MAIOR_K);
+    c->semente = sortear(sorteio) | 1;
+}
+
+// Tabuleiro apontando pras celulas do caso; so a matriz precisa ser liberada
+static void montar_tabuleiro(Caso *c, Tabuleiro *tab)
+{
+    tab->tamanho = c->tamanho;
+    tab->matriz = (char **)malloc(c->tamanho * sizeof(char *));
+    for (int i = 0; i < c->tamanho; i++)
+    {
+        tab->matriz[i] = c->celulas + i * c->tamanho;
+    }
+}
+
+static NoTrie *montar_trie(Caso *c)
+{
+    NoTrie *trie = criar_no_trie();
+    for (int i = 0; i < c->num_palavras; i++)
+    {
+        inserir_trie(trie, c->palavras[i]);
+    }
+    return trie;
+}
+
+static void escrever_letra(FILE *f, char letra)
+{
+    char utf8[2];
+    fwrite(utf8, 1, letra_para_utf8(letra, utf8), f);
+}
+
+// Tabuleiro no formato de tabuleiro.txt
+static void escrever_tabuleiro(FILE *f, Caso *c)
+{
+    fprintf(f, "%d %d\n", c->tamanho, c->tamanho);
+    for (int i = 0; i < c->tamanho; i++)
+    {
+        for (int j = 0; j < c->tamanho; j++)
+        {
+            escrever_letra(f, (char)MAIUSCULA_ALFABETO[INDICE_LETRA(c->celulas[i * c->tamanho + j])]);
+            fputc(j + 1 < c->tamanho ? ' ' : '\n', f);
+        }
+    }
+}
+
+// Dicionario no formato de palavras.txt
+static void escrever_palavras(FILE *f, Caso *c)
+{
+    for (int i = 0; i < c->num_palavras; i++)
+    {
+        for (const char *p = c->palavras[i]; *p; p++)
+        {
+            escrever_letra(f, *p);
+        }
+        fputc('\n', f);
+    }
+}
+
+static int gravar_tabuleiro(Caso *c, const char *arquivo)
+{
+    FILE *f = fopen(arquivo, "w");
+    if (!f)
+    {
+        return 0;
+    }
+    escrever_tabuleiro(f, c);
+    return fclose(f) == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Comparacao
+
+static int contar_nos(NoAVL *raiz)
+{
+    return raiz ? 1 + contar_nos(raiz->esquerdo) + contar_nos(raiz->direito) : 0;
+}
+
+// Poe os nos da arvore em ordem alfabetica no vetor; retorna a nova posicao
+static int listar_nos(NoAVL *raiz, NoAVL **lista, int n)
+{
+    if (!raiz)
+    {
+        return n;
+    }
+    n = listar_nos(raiz->esquerdo, lista, n);
+    lista[n++] = raiz;
+    return listar_nos(raiz->direito, lista, n);
+}
+
+// "palavra [(l,c) -> (l,c)]" em UTF-8, ou "nada" sem palavra
+static void descrever(char *destino, size_t tamanho, const char *palavra, Coordenadas c)
+{
+    char utf8[2 * MAIOR_TABULEIRO + 1];
+    int n = 0;
+
+    if (!palavra)
+    {
+        snprintf(destino, tamanho, "nada");
+        return;
+    }
+    for (; *palavra && n < 2 * MAIOR_TABULEIRO - 1; palavra++)
+    {
+        n += letra_para_utf8(*palavra, utf8 + n);
+    }
+    utf8[n] = '\0';
+    snprintf(destino, tamanho, "%s [(%d,%d) -> (%d,%d)]", utf8,
+             c.linha_inicio, c.coluna_inicio, c.linha_fim, c.coluna_fim);
+}
+
+static int mesma_ocorrencia(const char *a, Coordenadas ca, const char *b, Coordenadas cb)
+{
+    return strcmp(a, b) == 0 && ca.linha_inicio == cb.linha_inicio && ca.coluna_inicio == cb.coluna_inicio &&
+           ca.linha_fim == cb.linha_fim && ca.coluna_fim == cb.coluna_fim;
+}
+
+// Aponta a primeira posicao em que as listas diferem
+static void descrever_diferenca(char *detalhe, int posicao, const char *esperada, Coordenadas ce,
+                                const char *obtida, Coordenadas co)
+{
+    char texto_esperada[TAMANHO_DETALHE / 2 - 64];
+    char texto_obtida[TAMANHO_DETALHE / 2 - 64];
+    descrever(texto_esperada, sizeof(texto_esperada), esperada, ce);
+    descrever(texto_obtida, sizeof(texto_obtida), obtida, co);
+    snprintf(detalhe, TAMANHO_DETALHE, "posicao %d: esperado %s, veio %s",
+             posicao, texto_esperada, texto_obtida);
+}
+
+// Compara as duas arvores palavra por palavra, coordenadas incluidas
+static int comparar_arvores(NoAVL *esperada, NoAVL *obtida, char *detalhe)
+{
+    int total_esperado = contar_nos(esperada);
+    int total_obtido = contar_nos(obtida);
+    NoAVL **lista_esperada = (NoAVL **)malloc((total_esperado + 1) * sizeof(NoAVL *));
+    NoAVL **lista_obtida = (NoAVL **)malloc((total_obtido + 1) * sizeof(NoAVL *));
+    listar_nos(esperada, lista_esperada, 0);
+    listar_nos(obtida, lista_obtida, 0);
+
+    int ok = 1;
+    Coordenadas vazia = {0, 0, 0, 0};
+    for (int i = 0; ok && (i < total_esperado || i < total_obtido); i++)
+    {
+        NoAVL *a = i < total_esperado ? lista_esperada[i] : NULL;
+        NoAVL *b = i < total_obtido ? lista_obtida[i] : NULL;
+        if (!a || !b || !mesma_ocorrencia(a->palavra, a->coord, b->palavra, b->coord))
+        {
+            descrever_diferenca(detalhe, i, a ? a->palavra : NULL, a ? a->coord : vazia,
+                                b ? b->palavra : NULL, b ? b->coord : vazia);
+            ok = 0;
+        }
+    }
+
+    free(lista_esperada);
+    free(lista_obtida);
+    return ok;
+}
+
+// Acrescenta os parametros sorteados no fim da descricao
+static void anotar(char *detalhe, const char *formato, ...)
+{
+    size_t usado = strlen(detalhe);
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(detalhe + usado, TAMANHO_DETALHE - usado, formato, args);
+    va_end(args);
+}
+
+// ---------------------------------------------------------------------------
+// Motores
+
+static int motor_particionado(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe)
+{
+    (void)tab;
+    NoAVL *obtida = NULL;
+
+    if (!gravar_tabuleiro(c, arquivo_tabuleiro) ||
+        !buscar_palavras_particionado(arquivo_tabuleiro, trie, c->processos, c->bloco, &obtida))
+    {
+        snprintf(detalhe, TAMANHO_DETALHE, "a busca em blocos retornou erro");
+        return 0;
+    }
+
+    int ok = comparar_arvores(referencia, obtida, detalhe);
+    liberar_avl(obtida);
+    return ok;
+}
+
+// Cancela a busca incremental depois de um numero sorteado de palavras
+typedef struct
+{
+    volatile int *cancelar;
+    int faltam;
+    int chamadas;
+    unsigned sorteio;
+} Interrupcao;
+
+static void interromper(const char *palavra, Coordenadas coord, void *contexto)
+{
+    Interrupcao *in = (Interrupcao *)contexto;
+    (void)palavra;
+    (void)coord;
+
+    in->chamadas++;
+    if (--in->faltam <= 0)
+    {
+        *in->cancelar = 1;
+        in->faltam = 1 + sortear_ate(&in->sorteio, 8);
+    }
+}
+
+static int motor_incremental(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe)
+{
+    volatile int cancelar = 0;
+    Interrupcao in = {&cancelar, 0, 0, c->semente};
+    in.faltam = 1 + sortear_ate(&in.sorteio, 8);
+
+    EstadoBusca estado;
+    iniciar_estado_busca(&estado, trie);
+
+    int retomadas = 0;
+    while (buscar_palavras_incremental(tab, &estado, interromper, &in, 0, &cancelar) != BUSCA_CONCLUIDA)
+    {
+        cancelar = 0;
+        retomadas++;
+    }
+
+    int ok = comparar_arvores(referencia, estado.avl, detalhe);
+    int total = contar_nos(estado.avl);
+    if (ok && in.chamadas != total)
+    {
+        snprintf(detalhe, TAMANHO_DETALHE, "%d avisos de palavra nova para %d palavras", in.chamadas, total);
+        ok = 0;
+    }
+    if (!ok)
+    {
+        anotar(detalhe, " (%d retomadas)", retomadas);
+    }
+
+    liberar_estado_busca(&estado);
+    return ok;
+}
+
+// Tempo em milissegundos, no mesmo relogio de buscar_palavras_incremental
+static long long agora_ms()
+{
+#ifdef _WIN32
+    return (long long)clock() * 1000 / CLOCKS_PER_SEC;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+#endif
+}
+
+// Segura a primeira palavra de algumas chamadas ate o prazo passar, pra
+// proxima verificacao do relogio terminar a busca com BUSCA_PRAZO_ESGOTADO
+typedef struct
+{
+    int atrasos;
+    int primeira; // ainda nao veio palavra nesta chamada
+    int chamadas;
+} Atraso;
+
+static void atrasar(const char *palavra, Coordenadas coord, void *contexto)
+{
+    Atraso *a = (Atraso *)contexto;
+    (void)palavra;
+    (void)coord;
+
+    a->chamadas++;
+    if (a->primeira && a->atrasos > 0)
+    {
+        long long fim = agora_ms() + PRAZO_TESTE_MS + 1;
+        while (agora_ms() < fim)
+            ;
+        a->atrasos--;
+    }
+    a->primeira = 0;
+}
+
+static int motor_prazo(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe)
+{
+    (void)c;
+    Atraso a = {MAX_ATRASOS, 1, 0};
+    EstadoBusca estado;
+    iniciar_estado_busca(&estado, trie);
+
+    int esgotados = 0;
+    int ok = 1;
+    ResultadoBusca r;
+    while (ok && (r = buscar_palavras_incremental(tab, &estado, atrasar, &a, PRAZO_TESTE_MS, NULL)) != BUSCA_CONCLUIDA)
+    {
+        if (r != BUSCA_PRAZO_ESGOTADO)
+        {
+            snprintf(detalhe, TAMANHO_DETALHE, "busca sem cancelamento terminou com %d", (int)r);
+            ok = 0;
+        }
+        esgotados++;
+        a.primeira = 1;
+    }
+
+    ok = ok && comparar_arvores(referencia, estado.avl, detalhe);
+    int total = contar_nos(estado.avl);
+    if (ok && a.chamadas != total)
+    {
+        snprintf(detalhe, TAMANHO_DETALHE, "%d avisos de palavra nova para %d palavras", a.chamadas, total);
+        ok = 0;
+    }
+    if (!ok)
+    {
+        anotar(detalhe, " (prazo esgotado %d vezes)", esgotados);
+    }
+
+    liberar_estado_busca(&estado);
+    return ok;
+}
+
+static int motor_resolvedor(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe)
+{
+    Resolvedor *r = criar_resolvedor(trie);
+    NoAVL *obtida = resolver_celulas(r, c->celulas, c->tamanho);
+    int ok = comparar_arvores(referencia, obtida, detalhe);
+
+    // A segunda busca reaproveita a memoria da primeira
+    if (ok)
+    {
+        obtida = resolver_tabuleiro(r, tab);
+        ok = comparar_arvores(referencia, obtida, detalhe);
+        if (!ok)
+        {
+            anotar(detalhe, " (na segunda busca do mesmo contexto)");
+        }
+    }
+    if (ok && total_resolvido(r) != contar_nos(referencia))
+    {
+        snprintf(detalhe, TAMANHO_DETALHE, "total_resolvido deu %d, esperado %d",
+                 total_resolvido(r), contar_nos(referencia));
+        ok = 0;
+    }
+
+    liberar_resolvedor(r);
+    return ok;
+}
+
+static int motor_cache(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe)
+{
+    (void)c;
+    unsigned long long versao = versao_dicionario(trie);
+    NoAVL *obtida = NULL;
+
+    if (!salvar_cache(diretorio_cache, tab, versao, referencia, 0))
+    {
+        snprintf(detalhe, TAMANHO_DETALHE, "nao gravou o cache");
+        return 0;
+    }
+    if (!carregar_cache(diretorio_cache, tab, versao, &obtida))
+    {
+        snprintf(detalhe, TAMANHO_DETALHE, "nao achou o cache que acabou de gravar");
+        return 0;
+    }
+
+    int ok = comparar_arvores(referencia, obtida, detalhe);
+    liberar_avl(obtida);
+    return ok;
+}
+
+// Mesma ordem de buscar_maiores_palavras: maior primeiro, empate alfabetico
+static int comparar_ranking(const void *a, const void *b)
+{
+    const NoAVL *x = *(NoAVL *const *)a;
+    const NoAVL *y = *(NoAVL *const *)b;
+    int tx = (int)strlen(x->palavra), ty = (int)strlen(y->palavra);
+    return tx != ty ? ty - tx : strcmp(x->palavra, y->palavra);
+}
+
+static int motor_maiores(Caso *c, Tabuleiro *tab, NoTrie *trie, NoAVL *referencia, char *detalhe)
+{
+    int total = contar_nos(referencia);
+    int k = c->k;
+    int esperadas = k < total ? k : total;
+
+    NoAVL **lista = (NoAVL **)malloc((total + 1) * sizeof(NoAVL *));
+    listar_nos(referencia, lista, 0);
+    qsort(lista, total, sizeof(NoAVL *), comparar_ranking);
+
+    PalavraEncontrada *obtidas = (PalavraEncontrada *)malloc(k * sizeof(PalavraEncontrada));
+    int achadas = buscar_maiores_palavras(tab, trie, k, obtidas);
+
+    int ok = 1;
+    Coordenadas vazia = {0, 0, 0, 0};
+    for (int i = 0; ok && (i < esperadas || i < achadas); i++)
+    {
+        NoAVL *a = i < esperadas ? lista[i] : NULL;
+        PalavraEncontrada *b = i < achadas ? &obtidas[i] : NULL;
+        if (!a || !b || !mesma_ocorrencia(a->palavra, a->coord, b->palavra, b->coord))
+        {
+            descrever_diferenca(detalhe, i, a ? a->palavra : NULL, a ? a->coord : vazia,
+                                b ? b->palavra : NULL, b ? b->coord : vazia);
+            anotar(detalhe, " (%d palavras no total)", total);
+            ok = 0;
+        }
+    }
+
+    liberar_maiores_palavras(obtidas, achadas);
+    free(obtidas);
+    free(lista);
+    return ok;
+}
+
+static const Motor MOTORES[] = {
+    {"particionado", motor_particionado},
+    {"incremental", motor_incremental},
+    {"prazo", motor_prazo},
+    {"resolvedor", motor_resolvedor},
+    {"cache", motor_cache},
+    {"maiores", motor_maiores},
+};
+
+#define NUM_MOTORES ((int)(sizeof(MOTORES) / sizeof(MOTORES[0])))
+
+// ---------------------------------------------------------------------------
+// Execucao e reducao
+
+// Roda a referencia e o motor no caso; retorna 1 se bateram
+static int verificar_caso(Caso *c, const Motor *m, char *detalhe)
+{
+    Tabuleiro tab;
+    montar_tabuleiro(c, &tab);
+    NoTrie *trie = montar_trie(c);
+
+    NoAVL *referencia = buscar_palavras(&tab, trie);
+    int ok = m->funcao(c, &tab, trie, referencia, detalhe);
+
+    liberar_avl(referencia);
+    liberar_trie(trie);
+    free(tab.matriz);
+    return ok;
+}
+
+// Fica com o candidato se ele ainda falha; se nao, descarta
+static int tentar(Caso *c, Caso *candidato, const Motor *m, char *detalhe, int *tentativas)
+{
+    char novo_detalhe[TAMANHO_DETALHE];
+    (*tentativas)++;
+
+    if (!verificar_caso(candidato, m, novo_detalhe))
+    {
+        free(c->celulas);
+        *c = *candidato;
+        memcpy(detalhe, novo_detalhe, TAMANHO_DETALHE);
+        return 1;
+    }
+    free(candidato->celulas);
+    return 0;
+}
+
+// Diminui o caso enquanto a falha continuar: baixa os parametros, tira
+// palavras, tira a primeira ou a ultima letra delas, corta uma linha e uma
+// coluna de cada canto e troca letras do tabuleiro por 'a'. Para quando
+// nenhuma mudanca mantem a falha
+static void reduzir_caso(Caso *c, const Motor *m, char *detalhe)
+{
+    int tentativas = 0;
+    int mudou = 1;
+    Caso candidato;
+
+    while (mudou && tentativas < MAX_TENTATIVAS_REDUCAO)
+    {
+        mudou = 0;
+
+        int *parametros[] = {&candidato.processos, &candidato.bloco, &candidato.k};
+        for (int p = 0; p < 3; p++)
+        {
+            copiar_caso(&candidato, c);
+            if (--*parametros[p] < 1)
+            {
+                free(candidato.celulas);
+                continue;
+            }
+            mudou |= tentar(c, &candidato, m, detalhe, &tentativas);
+        }
+
+        for (int i = c->num_palavras - 1; i >= 0; i--)
+        {
+            copiar_caso(&candidato, c);
+            memmove(candidato.palavras[i], candidato.palavras[i + 1],
+                    (candidato.num_palavras - i - 1) * sizeof(candidato.palavras[0]));
+            candidato.num_palavras--;
+            mudou |= tentar(c, &candidato, m, detalhe, &tentativas);
+        }
+
+        for (int i = 0; i < c->num_palavras; i++)
+        {
+            for (int lado = 0; lado < 2 && strlen(c->palavras[i]) > 1; lado++)
+            {
+                copiar_caso(&candidato, c);
+                char *palavra = candidato.palavras[i];
+                if (lado == 0)
+                {
+                    memmove(palavra, palavra + 1, strlen(palavra));
+                }
+                else
+                {
+                    palavra[strlen(palavra) - 1] = '\0';
+                }
+                mudou |= tentar(c, &candidato, m, detalhe, &tentativas);
+            }
+        }
+
+        for (int canto = 0; canto < 4 && c->tamanho > 1; canto++)
+        {
+            int n = c->tamanho - 1;
+            int linha_base = canto & 1, coluna_base = canto >> 1;
+            candidato = *c;
+            candidato.tamanho = n;
+            candidato.celulas = (char *)malloc(n * n);
+            for (int i = 0; i < n; i++)
+            {
+                memcpy(candidato.celulas + i * n, c->celulas + (i + linha_base) * c->tamanho + coluna_base, n);
+            }
+            mudou |= tentar(c, &candidato, m, detalhe, &tentativas);
+        }
+
+        for (int i = 0; i < c->tamanho * c->tamanho; i++)
+        {
+            if (c->celulas[i] != 'a')
+            {
+                copiar_caso(&candidato, c);
+                candidato.celulas[i] = 'a';
+                mudou |= tentar(c, &candidato, m, detalhe, &tentativas);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Arquivos temporarios
+
+static int criar_temporarios()
+{
+#ifdef _WIN32
+    snprintf(diretorio_temporario, sizeof(diretorio_temporario), "diferencial-%d", (int)getpid());
+    if (mkdir(diretorio_temporario, 0700) != 0)
+    {
+        return 0;
+    }
+#else
+    const char *base = getenv("TMPDIR");
+    snprintf(diretorio_temporario, sizeof(diretorio_temporario), "%s/diferencial-XXXXXX",
+             base && *base ? base : "/tmp");
+    if (!mkdtemp(diretorio_temporario))
+    {
+        return 0;
+    }
+#endif
+    snprintf(arquivo_tabuleiro, sizeof(arquivo_tabuleiro), "%s/tabuleiro.txt", diretorio_temporario);
+    snprintf(diretorio_cache, sizeof(diretorio_cache), "%s/cache", diretorio_temporario);
+    return mkdir(diretorio_cache, 0700) == 0;
+}
+
+static void remover_temporarios()
+{
+    DIR *d = opendir(diretorio_cache);
+    if (d)
+    {
+        struct dirent *entrada;
+        char caminho[600];
+        while ((entrada = readdir(d)) != NULL)
+        {
+            if (strcmp(entrada->d_name, ".") != 0 && strcmp(entrada->d_name, "..") != 0)
+            {
+                snprintf(caminho, sizeof(caminho), "%s/%s", diretorio_cache, entrada->d_name);
+                remove(caminho);
+            }
+        }
+        closedir(d);
+    }
+    rmdir(diretorio_cache);
+    remove(arquivo_tabuleiro);
+    rmdir(diretorio_temporario);
+}
+
+// Opcoes: -n N casos, -s S semente inicial (o caso i usa a semente S + i),
+// -t T lado maximo do tabuleiro e -m NOME roda so um motor
+int main(int argc, char *argv[])
+{
+    int casos = CASOS_PADRAO;
+    unsigned semente = 1;
+    int tamanho_maximo = TAMANHO_MAXIMO_PADRAO;
+    const char *so_motor = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            casos = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            semente = (unsigned)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            tamanho_maximo = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+        {
+            so_motor = argv[++i];
+        }
+        else
+        {
+            printf("Uso: %s [-n casos] [-s semente] [-t tamanho_maximo] [-m motor]\n", argv[0]);
+            printf("Motores:");
+            for (int m = 0; m < NUM_MOTORES; m++)
+            {
+                printf(" %s", MOTORES[m].nome);
+            }
+            printf("\n");
+            return 1;
+        }
+    }
+
+    if (tamanho_maximo < 1 || tamanho_maximo > MAIOR_TABULEIRO)
+    {
+        tamanho_maximo = tamanho_maximo < 1 ? 1 : MAIOR_TABULEIRO;
+    }
+
+    int num_motores = 0;
+    for (int m = 0; m < NUM_MOTORES; m++)
+    {
+        num_motores += !so_motor || strcmp(so_motor, MOTORES[m].nome) == 0;
+    }
+    if (num_motores == 0)
+    {
+        fprintf(stderr, "Motor desconhecido: %s\n", so_motor);
+        return 1;
+    }
+
+    if (!criar_temporarios())
+    {
+        fprintf(stderr, "Nao foi possivel criar o diretorio temporario\n");
+        return 1;
+    }
+
+    int falhou = 0;
+    for (int i = 0; i < casos && !falhou; i++)
+    {
+        unsigned sorteio = (semente + (unsigned)i) * 2654435761u | 1;
+        Caso c;
+        gerar_caso(&c, &sorteio, tamanho_maximo);
+
+        for (int m = 0; m < NUM_MOTORES && !falhou; m++)
+        {
+            char detalhe[TAMANHO_DETALHE];
+            if ((so_motor && strcmp(so_motor, MOTORES[m].nome) != 0) || verificar_caso(&c, &MOTORES[m], detalhe))
+            {
+                continue;
+            }
+
+            falhou = 1;
+            printf("FALHA: %s diferente de buscar_palavras no caso %d (-s %u -n 1)\n",
+                   MOTORES[m].nome, i, semente + (unsigned)i);
+            printf("  %s\n", detalhe);
+            fflush(stdout);
+
+            reduzir_caso(&c, &MOTORES[m], detalhe);
+            printf("Caso reduzido: %s\n", detalhe);
+            printf("Parametros: -p %d -b %d -k %d\n", c.processos, c.bloco, c.k);
+            printf("--- tabuleiro.txt ---\n");
+            escrever_tabuleiro(stdout, &c);
+            printf("--- palavras.txt ---\n");
+            escrever_palavras(stdout, &c);
+        }
+        free(c.celulas);
+    }
+
+    remover_temporarios();
+    if (!falhou)
+    {
+        printf("%d casos, %d motores: tudo igual a buscar_palavras\n", casos, num_motores);
+    }
+    return falhou;
+}
@@ -1,18 +1,24 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <time.h>
 #include "avl.h"
 #include "trie.h"
+#include "alfabeto.h"
+#include "varredura.h"
 #include "jogo.h"
 
+// De quantas em quantas posicoes a busca incremental olha o relogio e o cancelamento
+#define ANCORAS_POR_VERIFICACAO 256
+
 // Le o tabuleiro do arquivo e retorna uma estrutura com a matriz
 Tabuleiro *ler_tabuleiro(const char *arquivo)
 {
     FILE *f = fopen(arquivo, "r");
     if (!f)
     {
-        printf("Erro ao abrir arquivo %s\n", arquivo);
         return NULL;
     }
 
@@ -27,12 +33,8 @@ Tabuleiro *ler_tabuleiro(const char *arquivo)
         tab->matriz[i] = (char *)malloc(colunas * sizeof(char));
         for (int j = 0; j < colunas; j++)
         {
-            char c;
-            do
-            {
-                fscanf(f, " %c", &c);
-            } while (c == '\n' || c == '\r');
-            tab->matriz[i][j] = tolower(c);
+            int c = ler_letra(f);
+            tab->matriz[i][j] = c == EOF ? ' ' : (char)c;
         }
     }
 
@@ -40,13 +42,27 @@ Tabuleiro *ler_tabuleiro(const char *arquivo)
     return tab;
 }
 
-// Le as palavras do arquivo e insere na trie
+// Le so a primeira linha do arquivo do tabuleiro (linhas e colunas), sem
+// carregar as letras
+int ler_dimensoes_tabuleiro(const char *arquivo, int *linhas, int *colunas)
+{
+    FILE *f = fopen(arquivo, "r");
+    if (!f)
+    {
+        return 0;
+    }
+
+    int lidos = fscanf(f, "%d %d", linhas, colunas);
+    fclose(f);
+    return lidos == 2;
+}
+
+// Le as palavras do arquivo (em UTF-8) e insere na trie
 NoTrie *ler_palavras(const char *arquivo)
 {
     FILE *f = fopen(arquivo, "r");
     if (!f)
     {
-        printf("Erro ao abrir arquivo %s\n", arquivo);
         return NULL;
     }
 
@@ -55,10 +71,7 @@ NoTrie *ler_palavras(const char *arquivo)
 
     while (fscanf(f, "%s", palavra) != EOF)
     {
-        for (int i = 0; palavra[i]; i++)
-        {
-            palavra[i] = tolower(palavra[i]);
-        }
+        normalizar_palavra(palavra);
         inserir_trie(raiz, palavra);
     }
 
@@ -67,7 +80,7 @@ NoTrie *ler_palavras(const char *arquivo)
 }
 
 // Inverte uma string pra buscar palavras ao contrario
-void inverter_string(char *str)
+static void inverter_string(char *str)
 {
     int n = strlen(str);
     for (int i = 0; i < n / 2; i++)
@@ -79,7 +92,7 @@ void inverter_string(char *str)
 }
 
 // Busca palavras na horizontal (esquerda-direita e direita-esquerda)
-NoAVL *buscar_horizontal(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
+static NoAVL *buscar_horizontal(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 {
     for (int i = 0; i < tab->tamanho; i++)
     {
@@ -116,7 +129,7 @@ NoAVL *buscar_horizontal(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 }
 
 // Busca palavras na vertical (cima-baixo e baixo-cima)
-NoAVL *buscar_vertical(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
+static NoAVL *buscar_vertical(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 {
     for (int j = 0; j < tab->tamanho; j++)
     {
@@ -153,7 +166,7 @@ NoAVL *buscar_vertical(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 }
 
 // Busca palavras na diagonal principal (canto superior esquerdo pra inferior direito)
-NoAVL *buscar_diagonal_principal(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
+static NoAVL *buscar_diagonal_principal(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 {
     for (int i = 0; i < tab->tamanho; i++)
     {
@@ -190,7 +203,7 @@ NoAVL *buscar_diagonal_principal(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 }
 
 // Busca palavras na diagonal secundaria (canto superior direito pra inferior esquerdo)
-NoAVL *buscar_diagonal_secundaria(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
+static NoAVL *buscar_diagonal_secundaria(Tabuleiro *tab, NoTrie *trie, NoAVL *avl)
 {
     for (int i = 0; i < tab->tamanho; i++)
     {
@@ -239,6 +252,114 @@ NoAVL *buscar_palavras(Tabuleiro *tab, NoTrie *trie)
     return avl;
 }
 
+// Prepara um estado vazio pra buscar_palavras_incremental
+void iniciar_estado_busca(EstadoBusca *estado, NoTrie *trie)
+{
+    estado->varredor = criar_varredor(trie);
+    estado->avl = NULL;
+    estado->fase = 0;
+    estado->externo = 0;
+    estado->interno = 0;
+}
+
+// Descarta o que ja foi achado e volta pro comeco (ex: o tabuleiro mudou)
+void reiniciar_estado_busca(EstadoBusca *estado)
+{
+    liberar_avl(estado->avl);
+    estado->avl = NULL;
+    estado->fase = 0;
+    estado->externo = 0;
+    estado->interno = 0;
+}
+
+// Libera o estado e as palavras que ainda estiverem nele
+void liberar_estado_busca(EstadoBusca *estado)
+{
+    liberar_avl(estado->avl);
+    liberar_varredor(estado->varredor);
+    estado->avl = NULL;
+    estado->varredor = NULL;
+}
+
+// Tempo em milissegundos contado de um ponto fixo qualquer
+static long long agora_ms()
+{
+#ifdef _WIN32
+    return (long long)clock() * 1000 / CLOCKS_PER_SEC;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+#endif
+}
+
+// Dados que repassar_palavra precisa pra avisar quem chamou
+typedef struct
+{
+    EstadoBusca *estado;
+    FuncaoPalavra funcao;
+    void *contexto;
+} Repasse;
+
+// Guarda a palavra se ainda nao foi achada e avisa na hora pelo callback
+static int repassar_palavra(const char *palavra, Coordenadas coord, void *contexto)
+{
+    Repasse *r = (Repasse *)contexto;
+
+    if (!buscar_avl(r->estado->avl, palavra))
+    {
+        r->estado->avl = inserir_avl(r->estado->avl, palavra, coord);
+        if (r->funcao)
+        {
+            r->funcao(palavra, coord, r->contexto);
+        }
+    }
+    return 1;
+}
+
+// Continua a busca de onde o estado parou, na mesma ordem de buscar_palavras.
+// Para quando acabar o prazo (prazo_ms <= 0 e sem prazo) ou quando *cancelar
+// ficar diferente de 0. O relogio so e consultado entre posicoes iniciais, nunca
+// dentro da descida na trie
+ResultadoBusca buscar_palavras_incremental(Tabuleiro *tab, EstadoBusca *estado,
+                                           FuncaoPalavra funcao, void *contexto,
+                                           long prazo_ms, volatile int *cancelar)
+{
+    long long limite = prazo_ms > 0 ? agora_ms() + prazo_ms : 0;
+    int verificar = ANCORAS_POR_VERIFICACAO;
+    Janela jan = {tab->matriz, 0, 0, tab->tamanho, tab->tamanho};
+    Repasse r = {estado, funcao, contexto};
+
+    for (; estado->fase < NUM_FASES; estado->fase++, estado->externo = 0)
+    {
+        for (; estado->externo < tab->tamanho; estado->externo++, estado->interno = 0)
+        {
+            for (; estado->interno < tab->tamanho; estado->interno++)
+            {
+                if (--verificar == 0)
+                {
+                    verificar = ANCORAS_POR_VERIFICACAO;
+                    if (cancelar && *cancelar)
+                    {
+                        return BUSCA_CANCELADA;
+                    }
+                    if (limite && agora_ms() >= limite)
+                    {
+                        return BUSCA_PRAZO_ESGOTADO;
+                    }
+                }
+
+                int linha = LINHA_ANCORA(estado->fase, estado->externo, estado->interno);
+                int coluna = COLUNA_ANCORA(estado->fase, estado->externo, estado->interno);
+                varrer_ancora(estado->varredor, &jan, estado->fase, linha, coluna,
+                              repassar_palavra, &r);
+            }
+        }
+    }
+
+    return BUSCA_CONCLUIDA;
+}
+
 // Exibe o tabuleiro na tela
 void imprimir_tabuleiro(Tabuleiro *tab)
 {
@@ -247,7 +368,11 @@ void imprimir_tabuleiro(Tabuleiro *tab)
     {
         for (int j = 0; j < tab->tamanho; j++)
         {
-            printf("%c ", toupper(tab->matriz[i][j]));
+            int indice = INDICE_LETRA(tab->matriz[i][j]);
+            char letra = indice < 0 ? tab->matriz[i][j] : (char)MAIUSCULA_ALFABETO[indice];
+            char utf8[2];
+            fwrite(utf8, 1, letra_para_utf8(letra, utf8), stdout);
+            printf(" ");
         }
         printf("\n");
     }
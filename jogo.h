@@ -3,6 +3,7 @@
 
 #include "trie.h"
 #include "avl.h"
+#include "varredura.h"
 
 // Estrutura que representa o tabuleiro do jogo
 typedef struct
@@ -11,11 +12,43 @@ typedef struct
     int tamanho;
 } Tabuleiro;
 
+// Como terminou uma chamada de buscar_palavras_incremental
+typedef enum
+{
+    BUSCA_CONCLUIDA,
+    BUSCA_PRAZO_ESGOTADO,
+    BUSCA_CANCELADA
+} ResultadoBusca;
+
+// Estado de uma busca incremental: palavras ja achadas e a proxima posicao
+// a varrer, na mesma ordem de buscar_palavras. A arvore em avl continua sendo
+// do estado ate liberar_estado_busca (ou ate quem chamou tirar ela de la)
+typedef struct
+{
+    Varredor *varredor;
+    NoAVL *avl;
+    int fase;
+    int externo;
+    int interno;
+} EstadoBusca;
+
+// Chamada uma vez pra cada palavra nova, na hora em que ela e achada. palavra
+// aponta pro buffer de trabalho da varredura e so vale ate a funcao retornar;
+// quem quiser guardar precisa copiar
+typedef void (*FuncaoPalavra)(const char *palavra, Coordenadas coord, void *contexto);
+
 // Prototipos das funcoes do jogo
 Tabuleiro *ler_tabuleiro(const char *arquivo);
+int ler_dimensoes_tabuleiro(const char *arquivo, int *linhas, int *colunas);
 NoTrie *ler_palavras(const char *arquivo);
 NoAVL *buscar_palavras(Tabuleiro *tab, NoTrie *trie);
 void imprimir_tabuleiro(Tabuleiro *tab);
 void liberar_tabuleiro(Tabuleiro *tab);
+void iniciar_estado_busca(EstadoBusca *estado, NoTrie *trie);
+void reiniciar_estado_busca(EstadoBusca *estado);
+void liberar_estado_busca(EstadoBusca *estado);
+ResultadoBusca buscar_palavras_incremental(Tabuleiro *tab, EstadoBusca *estado,
+                                           FuncaoPalavra funcao, void *contexto,
+                                           long prazo_ms, volatile int *cancelar);
 
 #endif
\ No newline at end of file
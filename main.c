@@ -1,8 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include "jogo.h"
+#include "alfabeto.h"
+#include "particao.h"
+#include "cache.h"
+#include "saida.h"
+#include "maiores.h"
 
 // Mostra as opcoes do menu na tela pro usuario escolher
 void exibir_menu()
@@ -19,14 +23,121 @@ void exibir_menu()
     printf("Escolha uma opcao: ");
 }
 
-// Funcao principal que inicia tudo e controla o loop do jogo
-int main()
+// Opcoes da linha de comando
+typedef struct
 {
-    // Carrega o tabuleiro do arquivo txt
-    Tabuleiro *tabuleiro = ler_tabuleiro("tabuleiro.txt");
-    if (!tabuleiro)
+    int processos;
+    int tamanho_bloco;
+    const char *diretorio_cache;
+    long long limite_cache;
+    int exportar;
+    FormatoSaida formato;
+    int maiores;
+} Opcoes;
+
+// Busca as palavras do jeito escolhido nas opcoes, passando pelo cache se
+// tiver um. Retorna 0 em erro, 1 se buscou e 2 se o resultado veio do cache
+static int executar_busca(Tabuleiro *tabuleiro, NoTrie *trie, Opcoes *op, NoAVL **avl)
+{
+    unsigned long long versao = op->diretorio_cache ? versao_dicionario(trie) : 0;
+    if (op->diretorio_cache && carregar_cache(op->diretorio_cache, tabuleiro, versao, avl))
+    {
+        return 2;
+    }
+
+    if (op->processos > 0)
+    {
+        if (!buscar_palavras_particionado("tabuleiro.txt", trie, op->processos,
+                                          op->tamanho_bloco, avl))
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        *avl = buscar_palavras(tabuleiro, trie);
+    }
+
+    if (op->diretorio_cache &&
+        !salvar_cache(op->diretorio_cache, tabuleiro, versao, *avl, op->limite_cache))
+    {
+        fprintf(stderr, "Nao foi possivel gravar o cache em %s\n", op->diretorio_cache);
+    }
+    return 1;
+}
+
+// Funcao principal que inicia tudo e controla o loop do jogo.
+// Opcoes: -p N resolve em N processos, cada um com uma faixa de linhas,
+// -b T e quantas linhas cada processo varre de cada vez,
+// -c DIR guarda os resultados em DIR, -m MB limita o tamanho desse cache e
+// -s FORMATO (texto, tsv, jsonl ou bin) so busca e escreve tudo na saida padrao
+// e -k N escreve so as N maiores palavras, da maior pra menor (sem -p nem -c,
+// que nao se aplicam a essa busca)
+int main(int argc, char *argv[])
+{
+    Opcoes op = {0, TAMANHO_BLOCO_PADRAO, NULL, LIMITE_CACHE_PADRAO, 0, SAIDA_TEXTO, 0};
+    int limite_informado = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            op.processos = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+            op.tamanho_bloco = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            op.diretorio_cache = argv[++i];
+        }
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc && atoll(argv[i + 1]) > 0)
+        {
+            op.limite_cache = atoll(argv[++i]) * 1024 * 1024;
+            limite_informado = 1;
+        }
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc && formato_por_nome(argv[i + 1], &op.formato))
+        {
+            op.exportar = 1;
+            i++;
+        }
+        else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+        {
+            op.maiores = atoi(argv[++i]);
+            op.exportar = 1;
+        }
+        else
+        {
+            printf("Uso: %s [-p processos] [-b tamanho_bloco] [-c dir_cache] [-m limite_mb]"
+                   " [-s texto|tsv|jsonl|bin] [-k quantidade]\n", argv[0]);
+            printf("-m precisa de -c e de um limite maior que 0; -k nao aceita -p nem -c\n");
+            return 1;
+        }
+    }
+
+    // Combinacoes que seriam ignoradas em silencio
+    if (limite_informado && !op.diretorio_cache)
+    {
+        fprintf(stderr, "-m so vale junto com -c\n");
+        return 1;
+    }
+    if (op.maiores > 0 && (op.processos > 0 || op.diretorio_cache))
     {
-        printf("Erro ao carregar tabuleiro.\n");
+        fprintf(stderr, "-k nao pode ser usado com -p nem com -c\n");
+        return 1;
+    }
+
+    // Carrega o tabuleiro do arquivo txt. A busca em faixas le o arquivo por
+    // conta propria, entao sem cache (que precisa das letras pro hash) so o
+    // cabecalho e conferido aqui e o tabuleiro fica fora da memoria
+    Tabuleiro *tabuleiro = NULL;
+    int linhas, colunas;
+    int carregar = op.processos == 0 || op.diretorio_cache || op.maiores > 0;
+    if (carregar ? !(tabuleiro = ler_tabuleiro("tabuleiro.txt"))
+                 : !ler_dimensoes_tabuleiro("tabuleiro.txt", &linhas, &colunas))
+    {
+        fprintf(op.exportar ? stderr : stdout, "Erro ao carregar tabuleiro de tabuleiro.txt\n");
         return 1;
     }
 
@@ -34,11 +145,67 @@ int main()
     NoTrie *trie = ler_palavras("palavras.txt");
     if (!trie)
     {
-        printf("Erro ao carregar palavras.\n");
+        fprintf(op.exportar ? stderr : stdout, "Erro ao carregar palavras de palavras.txt\n");
         liberar_tabuleiro(tabuleiro);
         return 1;
     }
 
+    // Sem menu: so as maiores palavras, sem montar a arvore inteira
+    if (op.maiores > 0)
+    {
+        // Mais que o dicionario inteiro nunca vai ser achado
+        int quantidade = contar_palavras_trie(trie);
+        if (quantidade > op.maiores)
+        {
+            quantidade = op.maiores;
+        }
+        PalavraEncontrada *maiores = (PalavraEncontrada *)malloc((quantidade > 0 ? quantidade : 1) *
+                                                                 sizeof(PalavraEncontrada));
+        if (!maiores)
+        {
+            fprintf(stderr, "Memoria insuficiente para %d palavras\n", quantidade);
+            liberar_trie(trie);
+            liberar_tabuleiro(tabuleiro);
+            return 1;
+        }
+        int total = buscar_maiores_palavras(tabuleiro, trie, quantidade, maiores);
+
+        EscritorSaida *e = criar_escritor(SAIDA_PADRAO, op.formato, CAPACIDADE_SAIDA_PADRAO);
+        for (int i = 0; i < total; i++)
+        {
+            escrever_palavra_saida(e, maiores[i].palavra, maiores[i].coord);
+        }
+        int ok = liberar_escritor(e);
+
+        liberar_maiores_palavras(maiores, total);
+        free(maiores);
+        liberar_trie(trie);
+        liberar_tabuleiro(tabuleiro);
+        return ok ? 0 : 1;
+    }
+
+    // Sem menu: busca, escreve o resultado e termina
+    if (op.exportar)
+    {
+        NoAVL *resultado = NULL;
+        int ok = executar_busca(tabuleiro, trie, &op, &resultado);
+        if (ok)
+        {
+            EscritorSaida *e = criar_escritor(SAIDA_PADRAO, op.formato, CAPACIDADE_SAIDA_PADRAO);
+            escrever_resultados(e, resultado);
+            ok = liberar_escritor(e);
+        }
+        else
+        {
+            fprintf(stderr, "Erro na busca em blocos.\n");
+        }
+
+        liberar_avl(resultado);
+        liberar_trie(trie);
+        liberar_tabuleiro(tabuleiro);
+        return ok ? 0 : 1;
+    }
+
     NoAVL *avl = NULL;
     int opcao;
     int buscou = 0;
@@ -62,7 +229,16 @@ int main()
             if (!buscou)
             {
                 printf("\nBuscando palavras no tabuleiro...\n");
-                avl = buscar_palavras(tabuleiro, trie);
+                int origem = executar_busca(tabuleiro, trie, &op, &avl);
+                if (!origem)
+                {
+                    printf("Erro na busca em blocos.\n");
+                    break;
+                }
+                if (origem == 2)
+                {
+                    printf("Resultado carregado do cache.\n");
+                }
                 printf("Busca concluida!\n");
                 buscou = 1;
             }
@@ -91,19 +267,18 @@ int main()
                 scanf("%s", palavra);
                 getchar();
 
-                for (int i = 0; palavra[i]; i++)
-                {
-                    palavra[i] = tolower(palavra[i]);
-                }
+                normalizar_palavra(palavra);
 
+                printf("Palavra '");
+                imprimir_letras(palavra, 0);
                 if (buscar_avl(avl, palavra))
                 {
                     avl = remover_avl(avl, palavra);
-                    printf("Palavra '%s' removida com sucesso!\n", palavra);
+                    printf("' removida com sucesso!\n");
                 }
                 else
                 {
-                    printf("Palavra '%s' nao encontrada.\n", palavra);
+                    printf("' nao encontrada.\n");
                 }
             }
             else
@@ -113,7 +288,18 @@ int main()
             break;
 
         case 4:
-            imprimir_tabuleiro(tabuleiro);
+            if (!tabuleiro)
+            {
+                tabuleiro = ler_tabuleiro("tabuleiro.txt");
+            }
+            if (tabuleiro)
+            {
+                imprimir_tabuleiro(tabuleiro);
+            }
+            else
+            {
+                printf("\nErro ao carregar tabuleiro de tabuleiro.txt\n");
+            }
             break;
 
         case 5:
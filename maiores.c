@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avl.h"
+#include "trie.h"
+#include "varredura.h"
+#include "maiores.h"
+
+// Maior sequencia guardada na tabela de sequencias; valores ali dentro
+// querem dizer "pelo menos isso"
+#define SEQUENCIA_MAXIMA 255
+
+// Heap com as k melhores palavras ate agora; a pior fica em heap[0]. O
+// indice tem as mesmas palavras numa AVL, pra achar repetidas em O(log k)
+typedef struct
+{
+    PalavraEncontrada *heap;
+    NoAVL *indice;
+    int total;
+    int k;
+    Varredor *v;
+} Ranking;
+
+// Positivo se a fica na frente de b: maior primeiro e, no empate, a que vem
+// antes no alfabeto
+static int comparar_ranking(const PalavraEncontrada *a, const PalavraEncontrada *b)
+{
+    if (a->tamanho != b->tamanho)
+    {
+        return a->tamanho > b->tamanho ? 1 : -1;
+    }
+    return strcmp(b->palavra, a->palavra);
+}
+
+static void trocar(PalavraEncontrada *a, PalavraEncontrada *b)
+{
+    PalavraEncontrada temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Sobe o item ate o pai ser pior que ele
+static void subir(Ranking *r, int i)
+{
+    while (i > 0 && comparar_ranking(&r->heap[(i - 1) / 2], &r->heap[i]) > 0)
+    {
+        trocar(&r->heap[(i - 1) / 2], &r->heap[i]);
+        i = (i - 1) / 2;
+    }
+}
+
+// Desce o item ate os filhos serem melhores que ele
+static void descer(Ranking *r, int i)
+{
+    for (;;)
+    {
+        int pior = i;
+        int esq = 2 * i + 1, dir = 2 * i + 2;
+
+        if (esq < r->total && comparar_ranking(&r->heap[esq], &r->heap[pior]) < 0)
+        {
+            pior = esq;
+        }
+        if (dir < r->total && comparar_ranking(&r->heap[dir], &r->heap[pior]) < 0)
+        {
+            pior = dir;
+        }
+        if (pior == i)
+        {
+            return;
+        }
+        trocar(&r->heap[i], &r->heap[pior]);
+        i = pior;
+    }
+}
+
+// Coloca a palavra no heap se ela for melhor que a pior guardada. Quando o
+// heap enche, o tamanho da pior vira o minimo da varredura, cortando as
+// descidas que nao tem como chegar la
+static int considerar_palavra(const char *palavra, Coordenadas coord, void *contexto)
+{
+    Ranking *r = (Ranking *)contexto;
+    PalavraEncontrada candidata = {(char *)palavra, (int)strlen(palavra), coord};
+
+    if (r->total == r->k && comparar_ranking(&candidata, &r->heap[0]) <= 0)
+    {
+        return 1;
+    }
+
+    // Ja guardada: vale a primeira ocorrencia, como em buscar_palavras
+    if (buscar_no_avl(r->indice, palavra))
+    {
+        return 1;
+    }
+
+    // Com o heap cheio a nova palavra entra no lugar da pior; antes disso o
+    // heap cresce uma posicao e so entao ganha espaco pra palavra
+    int i = 0;
+    if (r->total < r->k)
+    {
+        i = r->total++;
+        r->heap[i].palavra = (char *)malloc(r->v->profundidade + 1);
+    }
+    else
+    {
+        r->indice = remover_avl(r->indice, r->heap[0].palavra);
+    }
+    r->indice = inserir_avl(r->indice, palavra, coord);
+    memcpy(r->heap[i].palavra, palavra, candidata.tamanho + 1);
+    r->heap[i].tamanho = candidata.tamanho;
+    r->heap[i].coord = coord;
+
+    if (i == 0)
+    {
+        descer(r, 0);
+    }
+    else
+    {
+        subir(r, i);
+    }
+
+    if (r->total == r->k)
+    {
+        r->v->tamanho_minimo = r->heap[0].tamanho;
+    }
+    return 1;
+}
+
+// Marca as letras que aparecem em alguma palavra do dicionario
+static void marcar_letras(NoTrie *no, int usadas[TAMANHO_ALFABETO])
+{
+    for (int i = 0; i < TAMANHO_ALFABETO; i++)
+    {
+        if (no->filhos[i])
+        {
+            usadas[i] = 1;
+            marcar_letras(no->filhos[i], usadas);
+        }
+    }
+}
+
+// Posicao da celula na tabela de sequencias: a ordem e a dos lacos da fase,
+// pra que a varredura leia a tabela em sequencia
+static int posicao_sequencia(int fase, int linha, int coluna, int n)
+{
+    return LINHA_ANCORA(fase, linha, coluna) * n + COLUNA_ANCORA(fase, linha, coluna);
+}
+
+// Pra cada celula, quantas celulas seguidas a partir dela na direcao da fase
+// (ate a borda) tem letras do dicionario. Nenhuma palavra maior que isso pode
+// comecar ali, entao a ancora e pulada sem descer na trie
+static void medir_sequencias(Tabuleiro *tab, int fase, const int usadas[TAMANHO_ALFABETO],
+                             unsigned char *sequencia)
+{
+    int n = tab->tamanho;
+    int dl, dc;
+    passo_fase(fase, &dl, &dc);
+
+    // De baixo pra cima e da direita pra esquerda a proxima celula da
+    // direcao ja foi medida
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int j = n - 1; j >= 0; j--)
+        {
+            int indice = INDICE_LETRA(tab->matriz[i][j]);
+            int li = i + dl, cj = j + dc;
+            int seguinte = li < n && cj >= 0 && cj < n ? sequencia[posicao_sequencia(fase, li, cj, n)] : 0;
+            int p = posicao_sequencia(fase, i, j, n);
+
+            if (indice < 0 || !usadas[indice])
+            {
+                sequencia[p] = 0;
+            }
+            else
+            {
+                sequencia[p] = (unsigned char)(seguinte < SEQUENCIA_MAXIMA ? seguinte + 1 : SEQUENCIA_MAXIMA);
+            }
+        }
+    }
+}
+
+static int comparar_decrescente(const void *a, const void *b)
+{
+    return comparar_ranking((const PalavraEncontrada *)b, (const PalavraEncontrada *)a);
+}
+
+// Varre o tabuleiro na ordem de buscar_palavras (pra dar as mesmas coordenadas),
+// mas so guarda k palavras e pula ancoras e descidas que ja nao podem entrar
+int buscar_maiores_palavras(Tabuleiro *tab, NoTrie *trie, int k, PalavraEncontrada *resultado)
+{
+    // Nao da pra achar mais palavras do que o dicionario tem
+    int palavras = contar_palavras_trie(trie);
+    if (k > palavras)
+    {
+        k = palavras;
+    }
+    if (k <= 0)
+    {
+        return 0;
+    }
+
+    Varredor *v = criar_varredor(trie);
+    Ranking r;
+    r.heap = resultado;
+    r.indice = NULL;
+    r.total = 0;
+    r.k = k;
+    r.v = v;
+
+    int usadas[TAMANHO_ALFABETO] = {0};
+    marcar_letras(trie, usadas);
+    int n = tab->tamanho;
+    unsigned char *sequencia = (unsigned char *)malloc(n > 0 ? (size_t)n * n : 1);
+
+    Janela jan = {tab->matriz, 0, 0, n, n};
+    for (int fase = 0; fase < NUM_FASES; fase++)
+    {
+        medir_sequencias(tab, fase, usadas, sequencia);
+
+        for (int externo = 0; externo < n; externo++)
+        {
+            for (int interno = 0; interno < n; interno++)
+            {
+                int linha = LINHA_ANCORA(fase, externo, interno);
+                int coluna = COLUNA_ANCORA(fase, externo, interno);
+                int seguidas = sequencia[externo * n + interno];
+
+                if (seguidas >= 2 && (seguidas >= v->tamanho_minimo || seguidas == SEQUENCIA_MAXIMA))
+                {
+                    varrer_ancora(v, &jan, fase, linha, coluna, considerar_palavra, &r);
+                }
+            }
+        }
+    }
+    free(sequencia);
+    liberar_avl(r.indice);
+
+    qsort(resultado, r.total, sizeof(PalavraEncontrada), comparar_decrescente);
+
+    liberar_varredor(v);
+    return r.total;
+}
+
+void liberar_maiores_palavras(PalavraEncontrada *resultado, int total)
+{
+    for (int i = 0; i < total; i++)
+    {
+        free(resultado[i].palavra);
+    }
+}
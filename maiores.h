@@ -0,0 +1,23 @@
+#ifndef MAIORES_H
+#define MAIORES_H
+
+#include "trie.h"
+#include "avl.h"
+#include "jogo.h"
+
+// Uma das palavras escolhidas por buscar_maiores_palavras
+typedef struct
+{
+    char *palavra;
+    int tamanho;
+    Coordenadas coord;
+} PalavraEncontrada;
+
+// Acha as k maiores palavras do tabuleiro (empate: ordem alfabetica), com as
+// mesmas coordenadas que buscar_palavras daria. Preenche resultado da maior pra
+// menor e retorna quantas achou. resultado precisa de espaco pra k itens ou pro
+// numero de palavras do dicionario, o que for menor: k maior que isso e cortado
+int buscar_maiores_palavras(Tabuleiro *tab, NoTrie *trie, int k, PalavraEncontrada *resultado);
+void liberar_maiores_palavras(PalavraEncontrada *resultado, int total);
+
+#endif
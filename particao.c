@@ -0,0 +1,297 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avl.h"
+#include "trie.h"
+#include "varredura.h"
+#include "particao.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+// Le a proxima letra do tabuleiro; o que faltar no fim do arquivo vira espaco
+static char ler_celula(FILE *f)
+{
+    int c = ler_letra(f);
+    return c == EOF ? ' ' : (char)c;
+}
+
+// Guarda so a primeira ocorrencia de cada palavra na ordem de buscar_palavras
+static int registrar_ocorrencia(const char *palavra, Coordenadas coord, void *contexto)
+{
+    NoAVL **avl = (NoAVL **)contexto;
+    NoAVL *no = buscar_no_avl(*avl, palavra);
+
+    if (!no)
+    {
+        *avl = inserir_avl(*avl, palavra, coord);
+    }
+    else if (comparar_ocorrencias(coord, no->coord) < 0)
+    {
+        no->coord = coord;
+    }
+    return 1;
+}
+
+// Le a proxima linha do tabuleiro (letras em UTF-8, convertidas uma a uma)
+static void ler_linha(FILE *f, char *linha, int colunas)
+{
+    for (int j = 0; j < colunas; j++)
+    {
+        linha[j] = ler_celula(f);
+    }
+}
+
+// Resolve as linhas [inicio, fim) juntando tudo em avl. A entrada comeca na
+// linha inicio e e lida uma vez so, em ordem; so ficam na memoria as
+// tamanho_bloco linhas sendo varridas mais a borda de baixo (do tamanho da
+// maior palavra), que e o que as palavras que comecam nelas podem alcancar
+static void processar_faixa(FILE *entrada, Varredor *v, int linhas, int colunas,
+                            int tamanho_bloco, int inicio, int fim, NoAVL **avl)
+{
+    int borda = v->profundidade > 0 ? v->profundidade - 1 : 0;
+    int capacidade = tamanho_bloco < linhas - borda ? tamanho_bloco + borda : linhas;
+    Janela jan = {NULL, inicio, 0, 0, colunas};
+    jan.matriz = (char **)malloc(capacidade * sizeof(char *));
+    char **descartadas = (char **)malloc(capacidade * sizeof(char *));
+    for (int i = 0; i < capacidade; i++)
+    {
+        jan.matriz[i] = (char *)malloc(colunas * sizeof(char));
+    }
+
+    int proxima = inicio;
+    for (int l0 = inicio; l0 < fim; l0 += tamanho_bloco)
+    {
+        int l1 = fim - l0 > tamanho_bloco ? l0 + tamanho_bloco : fim;
+        int ate = linhas - l1 > borda ? l1 + borda : linhas;
+
+        // As linhas acima de l0 ja foram varridas; os buffers delas vao pro
+        // fim da janela e recebem as proximas linhas
+        int descartar = l0 - jan.linha_base;
+        memcpy(descartadas, jan.matriz, descartar * sizeof(char *));
+        memmove(jan.matriz, jan.matriz + descartar, (capacidade - descartar) * sizeof(char *));
+        memcpy(jan.matriz + capacidade - descartar, descartadas, descartar * sizeof(char *));
+        jan.linha_base = l0;
+        jan.linhas -= descartar;
+
+        for (; proxima < ate; proxima++, jan.linhas++)
+        {
+            ler_linha(entrada, jan.matriz[jan.linhas], colunas);
+        }
+
+        for (int fase = 0; fase < NUM_FASES; fase++)
+        {
+            for (int i = l0; i < l1; i++)
+            {
+                for (int j = 0; j < colunas; j++)
+                {
+                    varrer_ancora(v, &jan, fase, i, j, registrar_ocorrencia, avl);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < capacidade; i++)
+    {
+        free(jan.matriz[i]);
+    }
+    free(jan.matriz);
+    free(descartadas);
+}
+
+#ifndef _WIN32
+// Manda as palavras do processo filho pro pai pelo pipe
+static void enviar_avl(FILE *f, NoAVL *raiz)
+{
+    if (raiz)
+    {
+        enviar_avl(f, raiz->esquerdo);
+        int tamanho = (int)strlen(raiz->palavra);
+        fwrite(&tamanho, sizeof(int), 1, f);
+        fwrite(raiz->palavra, 1, tamanho, f);
+        fwrite(&raiz->coord, sizeof(Coordenadas), 1, f);
+        enviar_avl(f, raiz->direito);
+    }
+}
+
+// Le as palavras de um filho e junta com as dos outros
+static void receber_avl(FILE *f, NoAVL **avl, int profundidade)
+{
+    char *palavra = (char *)malloc(profundidade + 1);
+    int tamanho;
+    Coordenadas coord;
+
+    while (fread(&tamanho, sizeof(int), 1, f) == 1)
+    {
+        if (tamanho < 0 || tamanho > profundidade ||
+            fread(palavra, 1, tamanho, f) != (size_t)tamanho ||
+            fread(&coord, sizeof(Coordenadas), 1, f) != 1)
+        {
+            break;
+        }
+        palavra[tamanho] = '\0';
+        registrar_ocorrencia(palavra, coord, avl);
+    }
+
+    free(palavra);
+}
+#endif
+
+int buscar_palavras_particionado(const char *arquivo, NoTrie *trie, int num_processos,
+                                 int tamanho_bloco, NoAVL **resultado)
+{
+    *resultado = NULL;
+
+    FILE *f = fopen(arquivo, "r");
+    int linhas, colunas;
+    if (!f || fscanf(f, "%d %d", &linhas, &colunas) != 2 || linhas < 0 || colunas < 0)
+    {
+        if (f)
+        {
+            fclose(f);
+        }
+        return 0;
+    }
+
+    // Faixas maiores que o tabuleiro nao mudam nada e estouram as contas
+    int maior_lado = linhas > colunas ? linhas : colunas;
+    if (tamanho_bloco < 1)
+    {
+        tamanho_bloco = TAMANHO_BLOCO_PADRAO;
+    }
+    if (tamanho_bloco > maior_lado)
+    {
+        tamanho_bloco = maior_lado > 0 ? maior_lado : 1;
+    }
+    if (num_processos > linhas)
+    {
+        num_processos = linhas;
+    }
+    if (num_processos < 1)
+    {
+        num_processos = 1;
+    }
+
+    Varredor *v = criar_varredor(trie);
+    NoAVL *avl = NULL;
+    int ok = 1;
+
+#ifdef _WIN32
+    // Sem fork: resolve o tabuleiro inteiro aqui mesmo
+    processar_faixa(f, v, linhas, colunas, tamanho_bloco, 0, linhas, &avl);
+#else
+    // Cada processo fica com um pedaco continuo das linhas. O pai passa uma
+    // vez pelo arquivo contando as letras e, ao chegar na primeira linha de
+    // uma faixa, anota a posicao e ja cria o processo dela, que abre o
+    // arquivo por conta propria a partir dali. Assim os processos comecam
+    // juntos e nenhum espera pelo outro; o pipe so traz as palavras de volta
+    int *leitura = (int *)malloc(num_processos * sizeof(int));
+    pid_t *filhos = (pid_t *)malloc(num_processos * sizeof(pid_t));
+    int criados = 0;
+    int linha_atual = 0;
+
+    fflush(stdout);
+    for (int w = 0; w < num_processos; w++)
+    {
+        int inicio = (int)((long long)linhas * w / num_processos);
+        int fim = (int)((long long)linhas * (w + 1) / num_processos);
+
+        for (; linha_atual < inicio; linha_atual++)
+        {
+            for (int j = 0; j < colunas; j++)
+            {
+                ler_celula(f);
+            }
+        }
+        long posicao = ftell(f);
+
+        int resultado_fd[2];
+        if (posicao < 0 || pipe(resultado_fd) != 0)
+        {
+            ok = 0;
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            close(resultado_fd[0]);
+            close(resultado_fd[1]);
+            ok = 0;
+            break;
+        }
+
+        if (pid == 0)
+        {
+            // Pontas que sao dos outros filhos. O arquivo do pai fica como
+            // esta: _exit nao mexe nele
+            for (int k = 0; k < criados; k++)
+            {
+                close(leitura[k]);
+            }
+            close(resultado_fd[0]);
+
+            NoAVL *local = NULL;
+            FILE *faixa = fopen(arquivo, "r");
+            int sucesso = faixa && fseek(faixa, posicao, SEEK_SET) == 0;
+            if (sucesso)
+            {
+                processar_faixa(faixa, v, linhas, colunas, tamanho_bloco, inicio, fim, &local);
+            }
+            FILE *saida = fdopen(resultado_fd[1], "wb");
+            if (sucesso && saida)
+            {
+                enviar_avl(saida, local);
+                sucesso = fflush(saida) == 0;
+            }
+            _exit(sucesso && saida ? 0 : 1);
+        }
+
+        close(resultado_fd[1]);
+        leitura[criados] = resultado_fd[0];
+        filhos[criados] = pid;
+        criados++;
+    }
+
+    for (int w = 0; w < criados; w++)
+    {
+        FILE *entrada = fdopen(leitura[w], "rb");
+        if (entrada)
+        {
+            receber_avl(entrada, &avl, v->profundidade);
+            fclose(entrada);
+        }
+        else
+        {
+            close(leitura[w]);
+            ok = 0;
+        }
+
+        int status;
+        if (waitpid(filhos[w], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            ok = 0;
+        }
+    }
+
+    free(leitura);
+    free(filhos);
+#endif
+
+    fclose(f);
+    liberar_varredor(v);
+
+    if (!ok)
+    {
+        liberar_avl(avl);
+        return 0;
+    }
+
+    *resultado = avl;
+    return 1;
+}
@@ -0,0 +1,20 @@
+#ifndef PARTICAO_H
+#define PARTICAO_H
+
+#include "trie.h"
+#include "avl.h"
+
+// Quantas linhas cada processo varre de cada vez
+#define TAMANHO_BLOCO_PADRAO 256
+
+// Resolve o tabuleiro do arquivo dividindo as linhas em faixas continuas, uma
+// por processo. O pai passa uma vez pelo arquivo so anotando onde cada faixa
+// comeca, sem guardar o tabuleiro; cada processo abre o arquivo nessa posicao
+// e le a sua faixa de tamanho_bloco em tamanho_bloco linhas. A memoria de um
+// processo fica em (tamanho_bloco + borda) linhas inteiras do tabuleiro, com a
+// borda do tamanho da maior palavra menos 1. O resultado fica igual ao de
+// buscar_palavras. Retorna 0 em caso de erro
+int buscar_palavras_particionado(const char *arquivo, NoTrie *trie, int num_processos,
+                                 int tamanho_bloco, NoAVL **resultado);
+
+#endif
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avl.h"
+#include "trie.h"
+#include "varredura.h"
+#include "resolvedor.h"
+
+// Tamanho minimo de cada bloco da arena de resultados
+#define TAMANHO_BLOCO_ARENA 65536
+
+// Usado so pra alinhar o que sai da arena
+typedef union
+{
+    void *ponteiro;
+    long long inteiro;
+    double real;
+} Alinhamento;
+
+// Bloco da arena; os blocos ficam numa lista e nunca sao liberados no reinicio
+typedef struct BlocoArena
+{
+    struct BlocoArena *proximo;
+    size_t usado;
+    size_t capacidade;
+    Alinhamento dados[];
+} BlocoArena;
+
+struct Resolvedor
+{
+    Varredor *varredor;
+    BlocoArena *primeiro;
+    BlocoArena *atual;
+    char *celulas;
+    char **linhas;
+    int capacidade_tabuleiro;
+    NoAVL *avl;
+    int total;
+};
+
+// Cria um bloco vazio com pelo menos capacidade bytes
+static BlocoArena *criar_bloco(size_t capacidade)
+{
+    BlocoArena *bloco = (BlocoArena *)malloc(sizeof(BlocoArena) + capacidade);
+    bloco->proximo = NULL;
+    bloco->usado = 0;
+    bloco->capacidade = capacidade;
+    return bloco;
+}
+
+// Pega memoria da arena, so criando bloco novo quando todos ja estao cheios
+static void *arena_alocar(Resolvedor *r, size_t bytes)
+{
+    bytes = (bytes + sizeof(Alinhamento) - 1) / sizeof(Alinhamento) * sizeof(Alinhamento);
+
+    while (r->atual->usado + bytes > r->atual->capacidade)
+    {
+        if (!r->atual->proximo)
+        {
+            r->atual->proximo = criar_bloco(bytes > TAMANHO_BLOCO_ARENA ? bytes : TAMANHO_BLOCO_ARENA);
+        }
+        r->atual = r->atual->proximo;
+    }
+
+    void *p = (char *)r->atual->dados + r->atual->usado;
+    r->atual->usado += bytes;
+    return p;
+}
+
+// Cria o contexto; a trie precisa continuar existindo enquanto ele for usado
+Resolvedor *criar_resolvedor(NoTrie *trie)
+{
+    Resolvedor *r = (Resolvedor *)malloc(sizeof(Resolvedor));
+    r->varredor = criar_varredor(trie);
+    r->primeiro = criar_bloco(TAMANHO_BLOCO_ARENA);
+    r->atual = r->primeiro;
+    r->celulas = NULL;
+    r->linhas = NULL;
+    r->capacidade_tabuleiro = 0;
+    r->avl = NULL;
+    r->total = 0;
+    return r;
+}
+
+// Esquece o resultado anterior mas guarda toda a memoria pra proxima busca
+void reiniciar_resolvedor(Resolvedor *r)
+{
+    for (BlocoArena *b = r->primeiro; b; b = b->proximo)
+    {
+        b->usado = 0;
+    }
+    r->atual = r->primeiro;
+    r->avl = NULL;
+    r->total = 0;
+}
+
+// Libera o contexto e tudo que ele alocou
+void liberar_resolvedor(Resolvedor *r)
+{
+    if (r)
+    {
+        BlocoArena *b = r->primeiro;
+        while (b)
+        {
+            BlocoArena *proximo = b->proximo;
+            free(b);
+            b = proximo;
+        }
+        liberar_varredor(r->varredor);
+        free(r->celulas);
+        free(r->linhas);
+        free(r);
+    }
+}
+
+// Guarda a palavra na arvore do contexto se ela ainda nao foi achada
+static int guardar_palavra(const char *palavra, Coordenadas coord, void *contexto)
+{
+    Resolvedor *r = (Resolvedor *)contexto;
+
+    if (buscar_avl(r->avl, palavra))
+    {
+        return 1;
+    }
+
+    size_t tamanho = strlen(palavra) + 1;
+    NoAVL *no = (NoAVL *)arena_alocar(r, sizeof(NoAVL));
+    no->palavra = (char *)arena_alocar(r, tamanho);
+    memcpy(no->palavra, palavra, tamanho);
+    no->coord = coord;
+    r->avl = inserir_no_avl(r->avl, no);
+    r->total++;
+    return 1;
+}
+
+// Varre o tabuleiro inteiro na mesma ordem de buscar_palavras
+static NoAVL *resolver_janela(Resolvedor *r, Janela *jan, int tamanho)
+{
+    reiniciar_resolvedor(r);
+
+    for (int fase = 0; fase < NUM_FASES; fase++)
+    {
+        for (int externo = 0; externo < tamanho; externo++)
+        {
+            for (int interno = 0; interno < tamanho; interno++)
+            {
+                int linha = LINHA_ANCORA(fase, externo, interno);
+                int coluna = COLUNA_ANCORA(fase, externo, interno);
+                varrer_ancora(r->varredor, jan, fase, linha, coluna, guardar_palavra, r);
+            }
+        }
+    }
+
+    return r->avl;
+}
+
+// Busca as palavras de um tabuleiro ja carregado, sem copiar a matriz
+NoAVL *resolver_tabuleiro(Resolvedor *r, Tabuleiro *tab)
+{
+    Janela jan = {tab->matriz, 0, 0, tab->tamanho, tab->tamanho};
+    return resolver_janela(r, &jan, tab->tamanho);
+}
+
+// Busca as palavras de um tabuleiro tamanho x tamanho guardado linha apos linha.
+// As letras (bytes Latin-1) sao copiadas em minusculo pra um buffer do
+// contexto que so cresce
+NoAVL *resolver_celulas(Resolvedor *r, const char *celulas, int tamanho)
+{
+    if (tamanho > r->capacidade_tabuleiro)
+    {
+        free(r->celulas);
+        free(r->linhas);
+        r->celulas = (char *)malloc((size_t)tamanho * tamanho);
+        r->linhas = (char **)malloc(tamanho * sizeof(char *));
+        r->capacidade_tabuleiro = tamanho;
+    }
+
+    for (int i = 0; i < tamanho; i++)
+    {
+        r->linhas[i] = r->celulas + (size_t)i * tamanho;
+        for (int j = 0; j < tamanho; j++)
+        {
+            r->linhas[i][j] = dobrar_letra(celulas[(size_t)i * tamanho + j]);
+        }
+    }
+
+    Janela jan = {r->linhas, 0, 0, tamanho, tamanho};
+    return resolver_janela(r, &jan, tamanho);
+}
+
+// Quantas palavras a ultima busca achou
+int total_resolvido(Resolvedor *r)
+{
+    return r->total;
+}
@@ -0,0 +1,24 @@
+#ifndef RESOLVEDOR_H
+#define RESOLVEDOR_H
+
+#include "trie.h"
+#include "avl.h"
+#include "jogo.h"
+
+// Contexto de busca reaproveitavel. Guarda a trie invertida, os buffers de
+// trabalho e a memoria das palavras achadas; depois da primeira busca, buscas
+// em tabuleiros do mesmo porte nao alocam mais nada. Cada thread usa o seu
+// proprio contexto; a trie pode ser compartilhada porque so e lida
+typedef struct Resolvedor Resolvedor;
+
+Resolvedor *criar_resolvedor(NoTrie *trie);
+void reiniciar_resolvedor(Resolvedor *r);
+void liberar_resolvedor(Resolvedor *r);
+
+// As arvores devolvidas pertencem ao contexto e valem ate a proxima busca,
+// reiniciar_resolvedor ou liberar_resolvedor. Nao use liberar_avl/remover_avl nelas
+NoAVL *resolver_tabuleiro(Resolvedor *r, Tabuleiro *tab);
+NoAVL *resolver_celulas(Resolvedor *r, const char *celulas, int tamanho);
+int total_resolvido(Resolvedor *r);
+
+#endif
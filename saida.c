@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "avl.h"
+#include "alfabeto.h"
+#include "saida.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define write _write
+#else
+#include <unistd.h>
+#endif
+
+// Identificacao do formato binario
+#define MAGICO_SAIDA "CPSB"
+#define VERSAO_SAIDA 1
+
+// Largura da coluna de palavras no formato texto (a mesma de imprimir_avl)
+#define LARGURA_TEXTO 15
+
+// Maior altura possivel de uma AVL com ate 2^31 nos, com folga
+#define ALTURA_MAXIMA 64
+
+// Espaco que um registro pode ocupar alem da propria palavra
+#define FOLGA_REGISTRO 96
+
+EscritorSaida *criar_escritor(int fd, FormatoSaida formato, size_t capacidade)
+{
+    if (capacidade < FOLGA_REGISTRO)
+    {
+        capacidade = CAPACIDADE_SAIDA_PADRAO;
+    }
+
+    EscritorSaida *e = (EscritorSaida *)malloc(sizeof(EscritorSaida));
+    e->fd = fd;
+    e->formato = formato;
+    e->buffer = (char *)malloc(capacidade);
+    e->usado = 0;
+    e->capacidade = capacidade;
+    e->erro = 0;
+
+    // O cabecalho do binario vai uma vez so, no comeco do fluxo
+    if (formato == SAIDA_BINARIO)
+    {
+        memcpy(e->buffer, MAGICO_SAIDA, 4);
+        e->buffer[4] = VERSAO_SAIDA;
+        e->usado = 5;
+    }
+    return e;
+}
+
+// Manda o buffer inteiro pro descritor, repetindo se o write escrever so uma parte
+int descarregar_escritor(EscritorSaida *e)
+{
+    size_t enviado = 0;
+
+    while (enviado < e->usado && !e->erro)
+    {
+        long n = (long)write(e->fd, e->buffer + enviado, (unsigned)(e->usado - enviado));
+        if (n < 0)
+        {
+            if (errno != EINTR)
+            {
+                e->erro = 1;
+            }
+            continue;
+        }
+        enviado += (size_t)n;
+    }
+
+    e->usado = 0;
+    return !e->erro;
+}
+
+// Descarrega o que faltar e libera o escritor; retorna 0 se alguma escrita falhou
+int liberar_escritor(EscritorSaida *e)
+{
+    if (!e)
+    {
+        return 1;
+    }
+
+    int ok = descarregar_escritor(e);
+    free(e->buffer);
+    free(e);
+    return ok;
+}
+
+// Garante espaco pra mais bytes no buffer, descarregando ou crescendo
+static char *reservar(EscritorSaida *e, size_t bytes)
+{
+    if (e->usado + bytes > e->capacidade)
+    {
+        descarregar_escritor(e);
+        if (bytes > e->capacidade)
+        {
+            e->capacidade = bytes;
+            e->buffer = (char *)realloc(e->buffer, e->capacidade);
+        }
+    }
+    return e->buffer + e->usado;
+}
+
+// Escreve o inteiro em decimal sem passar pelo printf
+static char *escrever_numero(char *p, int valor)
+{
+    char digitos[12];
+    int n = 0;
+    unsigned int v = valor < 0 ? 0u - (unsigned int)valor : (unsigned int)valor;
+
+    if (valor < 0)
+    {
+        *p++ = '-';
+    }
+    do
+    {
+        digitos[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+
+    while (n)
+    {
+        *p++ = digitos[--n];
+    }
+    return p;
+}
+
+// Inteiro de 32 bits em little-endian
+static char *escrever_binario(char *p, unsigned long v, int bytes)
+{
+    for (int k = 0; k < bytes; k++)
+    {
+        *p++ = (char)((v >> (8 * k)) & 0xFF);
+    }
+    return p;
+}
+
+// Copia a palavra em UTF-8 e devolve onde parou; em *letras fica quantas letras tinha
+static char *escrever_palavra(char *p, const char *palavra, int *letras)
+{
+    int n = 0;
+    for (; palavra[n]; n++)
+    {
+        p += letra_para_utf8(palavra[n], p);
+    }
+    *letras = n;
+    return p;
+}
+
+// Palavra entre aspas pro JSON, escapando o que precisar
+static char *escrever_palavra_json(char *p, const char *palavra)
+{
+    static const char HEX[] = "0123456789abcdef";
+
+    *p++ = '"';
+    for (; *palavra; palavra++)
+    {
+        unsigned char c = (unsigned char)*palavra;
+        if (c == '"' || c == '\\')
+        {
+            *p++ = '\\';
+            *p++ = (char)c;
+        }
+        else if (c < 0x20)
+        {
+            memcpy(p, "\\u00", 4);
+            p[4] = HEX[c >> 4];
+            p[5] = HEX[c & 0xF];
+            p += 6;
+        }
+        else
+        {
+            p += letra_para_utf8((char)c, p);
+        }
+    }
+    *p++ = '"';
+    return p;
+}
+
+// Monta um registro no formato do escritor direto no buffer
+void escrever_palavra_saida(EscritorSaida *e, const char *palavra, Coordenadas c)
+{
+    size_t tamanho = strlen(palavra);
+    char *inicio = reservar(e, tamanho * 6 + FOLGA_REGISTRO);
+    char *p = inicio;
+    int letras;
+
+    switch (e->formato)
+    {
+    case SAIDA_TEXTO:
+        p = escrever_palavra(p, palavra, &letras);
+        for (; letras < LARGURA_TEXTO; letras++)
+        {
+            *p++ = ' ';
+        }
+        memcpy(p, " [(", 3);
+        p = escrever_numero(p + 3, c.linha_inicio);
+        *p++ = ',';
+        p = escrever_numero(p, c.coluna_inicio);
+        memcpy(p, ") -> (", 6);
+        p = escrever_numero(p + 6, c.linha_fim);
+        *p++ = ',';
+        p = escrever_numero(p, c.coluna_fim);
+        memcpy(p, ")]\n", 3);
+        p += 3;
+        break;
+
+    case SAIDA_TSV:
+        p = escrever_palavra(p, palavra, &letras);
+        *p++ = '\t';
+        p = escrever_numero(p, c.linha_inicio);
+        *p++ = '\t';
+        p = escrever_numero(p, c.coluna_inicio);
+        *p++ = '\t';
+        p = escrever_numero(p, c.linha_fim);
+        *p++ = '\t';
+        p = escrever_numero(p, c.coluna_fim);
+        *p++ = '\n';
+        break;
+
+    case SAIDA_JSONL:
+        memcpy(p, "{\"palavra\":", 11);
+        p = escrever_palavra_json(p + 11, palavra);
+        memcpy(p, ",\"inicio\":[", 11);
+        p = escrever_numero(p + 11, c.linha_inicio);
+        *p++ = ',';
+        p = escrever_numero(p, c.coluna_inicio);
+        memcpy(p, "],\"fim\":[", 9);
+        p = escrever_numero(p + 9, c.linha_fim);
+        *p++ = ',';
+        p = escrever_numero(p, c.coluna_fim);
+        memcpy(p, "]}\n", 3);
+        p += 3;
+        break;
+
+    case SAIDA_BINARIO:
+    {
+        // O tamanho so e conhecido depois de converter pra UTF-8
+        char *fim = escrever_palavra(p + 2, palavra, &letras);
+        escrever_binario(p, (unsigned long)(fim - p - 2), 2);
+        p = escrever_binario(fim, (unsigned long)c.linha_inicio, 4);
+        p = escrever_binario(p, (unsigned long)c.coluna_inicio, 4);
+        p = escrever_binario(p, (unsigned long)c.linha_fim, 4);
+        p = escrever_binario(p, (unsigned long)c.coluna_fim, 4);
+        break;
+    }
+    }
+
+    e->usado += (size_t)(p - inicio);
+}
+
+// Escreve todas as palavras em ordem alfabetica. A arvore e percorrida com
+// uma pilha propria em vez de recursao; o buffer so vai pro descritor quando
+// enche ou em descarregar_escritor/liberar_escritor
+void escrever_resultados(EscritorSaida *e, NoAVL *raiz)
+{
+    NoAVL *pilha[ALTURA_MAXIMA];
+    int topo = 0;
+    NoAVL *atual = raiz;
+
+    while (atual || topo > 0)
+    {
+        while (atual)
+        {
+            pilha[topo++] = atual;
+            atual = atual->esquerdo;
+        }
+
+        atual = pilha[--topo];
+        escrever_palavra_saida(e, atual->palavra, atual->coord);
+        atual = atual->direito;
+    }
+}
+
+// Converte o nome usado na linha de comando pro formato
+int formato_por_nome(const char *nome, FormatoSaida *formato)
+{
+    static const char *NOMES[] = {"texto", "tsv", "jsonl", "bin"};
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (strcmp(nome, NOMES[i]) == 0)
+        {
+            *formato = (FormatoSaida)i;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <stddef.h>
+#include "avl.h"
+
+// Descritor da saida padrao
+#define SAIDA_PADRAO 1
+
+// Capacidade padrao do buffer de saida, em bytes
+#define CAPACIDADE_SAIDA_PADRAO (1 << 20)
+
+typedef enum
+{
+    SAIDA_TEXTO,   // igual a imprimir_avl: palavra [(l,c) -> (l,c)]
+    SAIDA_TSV,     // palavra, linha/coluna inicial e final separadas por tab
+    SAIDA_JSONL,   // um objeto JSON por linha
+    SAIDA_BINARIO  // cabecalho + registros de tamanho, palavra e 4 inteiros
+} FormatoSaida;
+
+// Escreve resultados num descritor de arquivo (arquivo, terminal ou pipe)
+// montando tudo num buffer grande e mandando com poucas chamadas a write.
+// O buffer e reaproveitado entre chamadas
+typedef struct
+{
+    int fd;
+    FormatoSaida formato;
+    char *buffer;
+    size_t usado;
+    size_t capacidade;
+    int erro;
+} EscritorSaida;
+
+EscritorSaida *criar_escritor(int fd, FormatoSaida formato, size_t capacidade);
+void escrever_resultados(EscritorSaida *e, NoAVL *raiz);
+void escrever_palavra_saida(EscritorSaida *e, const char *palavra, Coordenadas coord);
+int descarregar_escritor(EscritorSaida *e);
+int liberar_escritor(EscritorSaida *e);
+int formato_por_nome(const char *nome, FormatoSaida *formato);
+
+#endif
@@ -1,7 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include "trie.h"
 
 // Cria um novo no da trie inicializando os filhos como NULL
@@ -9,6 +8,7 @@ NoTrie *criar_no_trie()
 {
     NoTrie *no = (NoTrie *)malloc(sizeof(NoTrie));
     no->fim_palavra = 0;
+    no->profundidade_max = 0;
 
     for (int i = 0; i < TAMANHO_ALFABETO; i++)
     {
@@ -18,19 +18,28 @@ NoTrie *criar_no_trie()
     return no;
 }
 
-// Insere uma palavra na trie letra por letra convertendo pra minusculo
-void inserir_trie(NoTrie *raiz, const char *palavra)
+// Insere uma palavra (ja normalizada) na trie letra por letra. Palavras com
+// letras fora do alfabeto sao recusadas inteiras e a funcao retorna 0
+int inserir_trie(NoTrie *raiz, const char *palavra)
 {
     NoTrie *atual = raiz;
 
     for (int i = 0; palavra[i] != '\0'; i++)
     {
-        char c = tolower(palavra[i]);
-        int indice = c - 'a';
+        if (INDICE_LETRA(palavra[i]) < 0)
+        {
+            return 0;
+        }
+    }
+
+    int restante = (int)strlen(palavra);
+    for (int i = 0; palavra[i] != '\0'; i++, restante--)
+    {
+        int indice = INDICE_LETRA(palavra[i]);
 
-        if (indice < 0 || indice >= TAMANHO_ALFABETO)
+        if (atual->profundidade_max < restante)
         {
-            continue;
+            atual->profundidade_max = restante;
         }
 
         if (!atual->filhos[indice])
@@ -42,6 +51,7 @@ void inserir_trie(NoTrie *raiz, const char *palavra)
     }
 
     atual->fim_palavra = 1;
+    return 1;
 }
 
 // Verifica se uma palavra existe na trie percorrendo seus nos
@@ -51,10 +61,9 @@ int buscar_trie(NoTrie *raiz, const char *palavra)
 
     for (int i = 0; palavra[i] != '\0'; i++)
     {
-        char c = tolower(palavra[i]);
-        int indice = c - 'a';
+        int indice = INDICE_LETRA(palavra[i]);
 
-        if (indice < 0 || indice >= TAMANHO_ALFABETO || !atual->filhos[indice])
+        if (indice < 0 || !atual->filhos[indice])
         {
             return 0;
         }
@@ -82,4 +91,73 @@ void liberar_trie(NoTrie *raiz)
     }
 
     free(raiz);
+}
+
+// Retorna o tamanho da maior palavra guardada na trie
+int profundidade_trie(NoTrie *raiz)
+{
+    return raiz ? raiz->profundidade_max : 0;
+}
+
+// Conta quantas palavras estao guardadas na trie
+int contar_palavras_trie(NoTrie *raiz)
+{
+    if (!raiz)
+    {
+        return 0;
+    }
+
+    int total = raiz->fim_palavra ? 1 : 0;
+    for (int i = 0; i < TAMANHO_ALFABETO; i++)
+    {
+        total += contar_palavras_trie(raiz->filhos[i]);
+    }
+    return total;
+}
+
+// Percorre a trie guardando o caminho e insere cada palavra de tras pra frente
+static void inverter_trie_recursivo(NoTrie *no, int *caminho, int nivel, NoTrie *destino)
+{
+    if (no->fim_palavra)
+    {
+        NoTrie *atual = destino;
+        for (int k = nivel - 1; k >= 0; k--)
+        {
+            if (atual->profundidade_max < k + 1)
+            {
+                atual->profundidade_max = k + 1;
+            }
+            if (!atual->filhos[caminho[k]])
+            {
+                atual->filhos[caminho[k]] = criar_no_trie();
+            }
+            atual = atual->filhos[caminho[k]];
+        }
+        atual->fim_palavra = 1;
+    }
+
+    for (int i = 0; i < TAMANHO_ALFABETO; i++)
+    {
+        if (no->filhos[i])
+        {
+            caminho[nivel] = i;
+            inverter_trie_recursivo(no->filhos[i], caminho, nivel + 1, destino);
+        }
+    }
+}
+
+// Cria uma trie nova com todas as palavras escritas ao contrario
+NoTrie *inverter_trie(NoTrie *raiz)
+{
+    NoTrie *invertida = criar_no_trie();
+    if (!raiz)
+    {
+        return invertida;
+    }
+
+    int *caminho = (int *)malloc((profundidade_trie(raiz) + 1) * sizeof(int));
+    inverter_trie_recursivo(raiz, caminho, 0, invertida);
+    free(caminho);
+
+    return invertida;
 }
\ No newline at end of file
@@ -1,18 +1,22 @@
 #ifndef TRIE_H
 #define TRIE_H
 
-#define TAMANHO_ALFABETO 26
+#include "alfabeto.h"
 
 typedef struct NoTrie
 {
     struct NoTrie *filhos[TAMANHO_ALFABETO];
     int fim_palavra;
+    int profundidade_max; // maior numero de letras que ainda da pra andar abaixo deste no
 } NoTrie;
 
 // Prototipos
 NoTrie *criar_no_trie();
-void inserir_trie(NoTrie *raiz, const char *palavra);
+int inserir_trie(NoTrie *raiz, const char *palavra);
 int buscar_trie(NoTrie *raiz, const char *palavra);
 void liberar_trie(NoTrie *raiz);
+int profundidade_trie(NoTrie *raiz);
+int contar_palavras_trie(NoTrie *raiz);
+NoTrie *inverter_trie(NoTrie *raiz);
 
 #endif
\ No newline at end of file
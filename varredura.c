@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "varredura.h"
+
+// Passo de cada fase: direita, baixo, baixo-direita e baixo-esquerda
+static const int PASSO_LINHA[NUM_FASES] = {0, 1, 1, 1};
+static const int PASSO_COLUNA[NUM_FASES] = {1, 0, 1, -1};
+
+// Prepara a trie invertida e os buffers do tamanho da maior palavra
+Varredor *criar_varredor(NoTrie *trie)
+{
+    Varredor *v = (Varredor *)malloc(sizeof(Varredor));
+    v->trie = trie;
+    v->trie_invertida = inverter_trie(trie);
+    v->profundidade = profundidade_trie(trie);
+    v->tamanho_minimo = 0;
+    v->palavra = (char *)malloc(v->profundidade + 1);
+    v->invertida = (char *)malloc(v->profundidade + 1);
+    return v;
+}
+
+// Libera o varredor (a trie original continua sendo de quem chamou)
+void liberar_varredor(Varredor *v)
+{
+    if (v)
+    {
+        liberar_trie(v->trie_invertida);
+        free(v->palavra);
+        free(v->invertida);
+        free(v);
+    }
+}
+
+// Anda a partir de (linha, coluna) na direcao da fase descendo nas duas tries
+// ao mesmo tempo. Na trie normal acha as palavras lidas no sentido da fase e na
+// invertida as lidas ao contrario, na mesma ordem de tamanhos que buscar_palavras
+int varrer_ancora(Varredor *v, Janela *jan, int fase, int linha, int coluna,
+                  FuncaoOcorrencia funcao, void *contexto)
+{
+    NoTrie *direta = v->trie;
+    NoTrie *reversa = v->trie_invertida;
+    int dl = PASSO_LINHA[fase];
+    int dc = PASSO_COLUNA[fase];
+    int l = linha - jan->linha_base;
+    int c = coluna - jan->coluna_base;
+
+    for (int k = 0; l >= 0 && l < jan->linhas && c >= 0 && c < jan->colunas; k++, l += dl, c += dc)
+    {
+        char letra = jan->matriz[l][c];
+        int indice = INDICE_LETRA(letra);
+
+        if (indice < 0)
+        {
+            break;
+        }
+
+        direta = direta ? direta->filhos[indice] : NULL;
+        reversa = reversa ? reversa->filhos[indice] : NULL;
+
+        // Cada trie para sozinha quando nem a maior palavra abaixo do no
+        // alcanca o minimo
+        if (direta && k + 1 + direta->profundidade_max < v->tamanho_minimo)
+        {
+            direta = NULL;
+        }
+        if (reversa && k + 1 + reversa->profundidade_max < v->tamanho_minimo)
+        {
+            reversa = NULL;
+        }
+        if (!direta && !reversa)
+        {
+            break;
+        }
+
+        v->palavra[k] = letra;
+
+        // buscar_palavras so considera palavras com 2 letras ou mais, e as
+        // menores que o minimo nao interessam a quem pediu o minimo
+        if (k == 0 || k + 1 < v->tamanho_minimo)
+        {
+            continue;
+        }
+
+        if (direta && direta->fim_palavra)
+        {
+            v->palavra[k + 1] = '\0';
+            Coordenadas coord = {linha, coluna, linha + k * dl, coluna + k * dc};
+            if (!funcao(v->palavra, coord, contexto))
+            {
+                return 0;
+            }
+        }
+
+        if (reversa && reversa->fim_palavra)
+        {
+            for (int p = 0; p <= k; p++)
+            {
+                v->invertida[p] = v->palavra[k - p];
+            }
+            v->invertida[k + 1] = '\0';
+            Coordenadas coord = {linha + k * dl, coluna + k * dc, linha, coluna};
+            if (!funcao(v->invertida, coord, contexto))
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+// Passo da fase, pra quem precisa andar pelo tabuleiro na mesma direcao
+void passo_fase(int fase, int *linha, int *coluna)
+{
+    *linha = PASSO_LINHA[fase];
+    *coluna = PASSO_COLUNA[fase];
+}
+
+// Traduz as coordenadas pra posicao em que buscar_palavras as gera:
+// fase, laco externo, laco interno, tamanho e se foi achada invertida
+static void chave_ocorrencia(Coordenadas c, int chave[5])
+{
+    int dl = c.linha_fim - c.linha_inicio;
+    int dc = c.coluna_fim - c.coluna_inicio;
+    int linha = dl < 0 ? c.linha_fim : c.linha_inicio;
+    int tamanho = (dl != 0 ? abs(dl) : abs(dc)) + 1;
+
+    if (dl == 0)
+    {
+        chave[0] = 0;
+        chave[1] = c.linha_inicio;
+        chave[2] = dc < 0 ? c.coluna_fim : c.coluna_inicio;
+        chave[4] = dc < 0;
+    }
+    else if (dc == 0)
+    {
+        chave[0] = 1;
+        chave[1] = c.coluna_inicio;
+        chave[2] = linha;
+        chave[4] = dl < 0;
+    }
+    else
+    {
+        // Na diagonal o inicio da leitura direta e sempre a celula mais de cima
+        chave[0] = (dl > 0) == (dc > 0) ? 2 : 3;
+        chave[1] = linha;
+        chave[2] = dl < 0 ? c.coluna_fim : c.coluna_inicio;
+        chave[4] = dl < 0;
+    }
+    chave[3] = tamanho;
+}
+
+// Compara duas ocorrencias pela ordem em que buscar_palavras as encontraria
+int comparar_ocorrencias(Coordenadas a, Coordenadas b)
+{
+    int ca[5], cb[5];
+    chave_ocorrencia(a, ca);
+    chave_ocorrencia(b, cb);
+
+    for (int i = 0; i < 5; i++)
+    {
+        if (ca[i] != cb[i])
+        {
+            return ca[i] < cb[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
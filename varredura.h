@@ -0,0 +1,50 @@
+#ifndef VARREDURA_H
+#define VARREDURA_H
+
+#include "trie.h"
+#include "avl.h"
+
+// Fases na mesma ordem de buscar_palavras: horizontal, vertical,
+// diagonal principal e diagonal secundaria
+#define NUM_FASES 4
+
+// Celula da ancora na posicao (externo, interno) dos lacos de buscar_palavras.
+// Quem varre o tabuleiro inteiro precisa seguir essa ordem pra dar as mesmas
+// coordenadas: na vertical o laco de fora anda pelas colunas, nas outras fases
+// pelas linhas. Como so troca os dois, serve tambem pro caminho inverso
+#define LINHA_ANCORA(fase, externo, interno) ((fase) == 1 ? (interno) : (externo))
+#define COLUNA_ANCORA(fase, externo, interno) ((fase) == 1 ? (externo) : (interno))
+
+// Pedaco do tabuleiro que esta na memoria. matriz[0][0] e a celula
+// (linha_base, coluna_base) do tabuleiro completo
+typedef struct
+{
+    char **matriz;
+    int linha_base;
+    int coluna_base;
+    int linhas;
+    int colunas;
+} Janela;
+
+// Trie normal, trie com as palavras invertidas e buffers de trabalho
+typedef struct
+{
+    NoTrie *trie;
+    NoTrie *trie_invertida;
+    int profundidade;
+    int tamanho_minimo; // palavras menores nao sao avisadas e descidas que nao chegam nele sao cortadas
+    char *palavra;
+    char *invertida;
+} Varredor;
+
+// Chamada a cada palavra do dicionario achada; retornar 0 interrompe a varredura
+typedef int (*FuncaoOcorrencia)(const char *palavra, Coordenadas coord, void *contexto);
+
+Varredor *criar_varredor(NoTrie *trie);
+void liberar_varredor(Varredor *v);
+int varrer_ancora(Varredor *v, Janela *jan, int fase, int linha, int coluna,
+                  FuncaoOcorrencia funcao, void *contexto);
+int comparar_ocorrencias(Coordenadas a, Coordenadas b);
+void passo_fase(int fase, int *linha, int *coluna);
+
+#endif